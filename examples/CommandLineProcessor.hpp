@@ -3,8 +3,9 @@
 
 struct CommandLineProcessor {
 
-    int order, dimension, number_target_coords, number_source_coords, number_of_batches;
-    std::string constraint_name, solver_name, problem_name;
+    int order, dimension, number_target_coords, number_source_coords, number_of_batches, number_of_neighbor_buckets, pipeline_batches, fuse_standard_solve, solve_targets_first;
+    double memory_budget_in_MB;
+    std::string constraint_name, solver_name, problem_name, precision_name, alpha_storage_name;
 
     CommandLineProcessor(int argc, char* args[], const bool print=true) {
 
@@ -13,10 +14,17 @@ struct CommandLineProcessor {
         number_target_coords = 200; 
         number_source_coords = -1; 
         number_of_batches = 1; 
+        number_of_neighbor_buckets = 1; 
+        pipeline_batches = 0; 
+        fuse_standard_solve = 0; 
+        solve_targets_first = 1; 
+        memory_budget_in_MB = -1; 
     
         constraint_name = "NO_CONSTRAINT"; // "NEUMANN_GRAD_SCALAR"
-        solver_name = "QR"; // LU
+        solver_name = "QR"; // CHOLESKY (or LU, a deprecated alias of CHOLESKY)
         problem_name = "STANDARD"; // MANIFOLD
+        precision_name = "DOUBLE"; // MIXED
+        alpha_storage_name = "DOUBLE"; // FLOAT, INT16
 
         for (int i = 1; i < argc; ++i) {
             if (i + 1 < argc) { // not at end
@@ -30,12 +38,26 @@ struct CommandLineProcessor {
                    number_source_coords = atoi(args[i+1]); 
                 } else if (std::string(args[i]) == "--nb") {
                    number_of_batches = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--nbuckets") {
+                   number_of_neighbor_buckets = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--pipeline") {
+                   pipeline_batches = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--fuse") {
+                   fuse_standard_solve = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--targets-first") {
+                   solve_targets_first = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--memory") {
+                   memory_budget_in_MB = atof(args[i+1]); 
                 } else if (std::string(args[i]) == "--solver") {
                    solver_name = std::string(args[i+1]); 
                 } else if (std::string(args[i]) == "--problem") {
                    problem_name = std::string(args[i+1]); 
                 } else if (std::string(args[i]) == "--constraint") {
                    constraint_name = std::string(args[i+1]); 
+                } else if (std::string(args[i]) == "--precision") {
+                   precision_name = std::string(args[i+1]); 
+                } else if (std::string(args[i]) == "--alphas") {
+                   alpha_storage_name = std::string(args[i+1]); 
                 }
             }
         }
@@ -0,0 +1,236 @@
+/*
+ *
+ * This example tests generating alphas with a polynomial order set for each target site, where most
+ * target sites use the order given on the command line and every fifth target site uses an order two
+ * higher, compared against generating alphas for all target sites with each of the two orders. Every third
+ * target site then switches to the other order and is regenerated, compared against alphas generated from
+ * scratch with the orders after regeneration.
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <cstdio>
+#include <random>
+
+#include <Compadre_Config.h>
+#include <Compadre_GMLS.hpp>
+#include <Compadre_Evaluator.hpp>
+
+#include "GMLS_Tutorial.hpp"
+#include "CommandLineProcessor.hpp"
+
+#ifdef COMPADRE_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <Kokkos_Timer.hpp>
+#include <Kokkos_Core.hpp>
+
+using namespace Compadre;
+
+// called from command line
+int main (int argc, char* args[]) {
+
+// initializes MPI (if available) with command line arguments given
+#ifdef COMPADRE_USE_MPI
+MPI_Init(&argc, &args);
+#endif
+
+// initializes Kokkos with command line arguments given
+Kokkos::initialize(argc, args);
+
+// becomes false if the solution with mixed orders is not within the failure_threshold of the reference solutions
+bool all_passed = true;
+
+// code block to reduce scope for all Kokkos View allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+{
+
+    CommandLineProcessor clp(argc, args);
+    auto order = clp.order;
+    auto dimension = clp.dimension;
+    auto number_target_coords = clp.number_target_coords;
+    auto constraint_name = clp.constraint_name;
+    auto solver_name = clp.solver_name;
+    auto problem_name = clp.problem_name;
+    auto number_of_batches = clp.number_of_batches;
+
+    // alphas of each target site should match those solved with the same order for all target sites
+    const double failure_tolerance = 1e-8;
+
+    // order used at every fifth target site
+    const int high_order = order + 2;
+
+    // each neighborhood has twice as many neighbors as the size of the higher order polynomial basis
+    const int number_of_neighbors = 2*Compadre::GMLS::getNP(high_order, dimension);
+
+    // coordinates of target sites, and of a separate set of source sites in [-1,1]^dimension around each target site
+    std::mt19937 rng(50);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const int number_source_coords = number_target_coords*number_of_neighbors;
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> source_coords_device("source coordinates",
+            number_source_coords, 3);
+    Kokkos::View<double**>::HostMirror source_coords = Kokkos::create_mirror_view(source_coords_device);
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> target_coords_device("target coordinates",
+            number_target_coords, 3);
+    Kokkos::View<double**>::HostMirror target_coords = Kokkos::create_mirror_view(target_coords_device);
+    Kokkos::View<int*> neighbor_lists_device("neighbor lists", number_source_coords);
+    Kokkos::View<int*>::HostMirror neighbor_lists = Kokkos::create_mirror_view(neighbor_lists_device);
+    Kokkos::View<int*> number_of_neighbors_list_device("number of neighbor lists", number_target_coords);
+    Kokkos::View<int*>::HostMirror number_of_neighbors_list = Kokkos::create_mirror_view(number_of_neighbors_list_device);
+    Kokkos::View<double*> epsilon_device("h supports", number_target_coords);
+    Kokkos::View<double*>::HostMirror epsilon = Kokkos::create_mirror_view(epsilon_device);
+    Kokkos::View<int*, Kokkos::HostSpace> poly_orders("polynomial orders", number_target_coords);
+
+    for (int i=0; i<number_target_coords; ++i) {
+        for (int d=0; d<dimension; ++d) target_coords(i,d) = 0.5*uniform(rng);
+        poly_orders(i) = (i%5 == 4) ? high_order : order;
+        epsilon(i) = 1.5*std::sqrt((double)dimension);
+        number_of_neighbors_list(i) = number_of_neighbors;
+        for (int j=0; j<number_of_neighbors; ++j) {
+            const int source_index = i*number_of_neighbors + j;
+            for (int d=0; d<dimension; ++d) {
+                source_coords(source_index,d) = target_coords(i,d) + uniform(rng);
+            }
+            neighbor_lists(source_index) = source_index;
+        }
+    }
+    Kokkos::deep_copy(source_coords_device, source_coords);
+    Kokkos::deep_copy(target_coords_device, target_coords);
+    Kokkos::deep_copy(neighbor_lists_device, neighbor_lists);
+    Kokkos::deep_copy(number_of_neighbors_list_device, number_of_neighbors_list);
+    Kokkos::deep_copy(epsilon_device, epsilon);
+
+    // need Kokkos View storing true solution
+    Kokkos::View<double*, Kokkos::DefaultExecutionSpace> sampling_data_device("samples of true solution",
+            source_coords_device.extent(0));
+    Kokkos::parallel_for("Sampling Manufactured Solutions", Kokkos::RangePolicy<Kokkos::DefaultExecutionSpace>
+            (0,source_coords.extent(0)), KOKKOS_LAMBDA(const int i) {
+        double xval = source_coords_device(i,0);
+        double yval = (dimension>1) ? source_coords_device(i,1) : 0;
+        double zval = (dimension>2) ? source_coords_device(i,2) : 0;
+        sampling_data_device(i) = trueSolution(xval, yval, zval, high_order, dimension);
+    });
+
+    std::vector<TargetOperation> lro(3);
+    lro[0] = ScalarPointEvaluation;
+    lro[1] = LaplacianOfScalarPointEvaluation;
+    lro[2] = GradientOfScalarPointEvaluation;
+
+    // generate alphas with the order of each target site
+    Kokkos::Timer timer;
+    GMLS my_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    my_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    my_GMLS.setPolynomialOrders(poly_orders);
+    my_GMLS.addTargets(lro);
+    my_GMLS.setWeightingType(WeightingFunctionType::Power);
+    my_GMLS.setWeightingPower(2);
+    my_GMLS.generateAlphas(number_of_batches);
+    std::cout << "Took " << timer.seconds() << "s to generate alphas with an order for each target site." << std::endl;
+
+    // every third target site switches to the other order, and only those target sites are regenerated
+    std::vector<int> regenerated_targets;
+    for (int i=0; i<number_target_coords; i+=3) {
+        poly_orders(i) = (poly_orders(i) == order) ? high_order : order;
+        regenerated_targets.push_back(i);
+    }
+    my_GMLS.setPolynomialOrders(poly_orders);
+    my_GMLS.regenerateAlphas(regenerated_targets, number_of_batches);
+
+    // generate alphas for all target sites with the orders after regeneration
+    GMLS fresh_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    fresh_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    fresh_GMLS.setPolynomialOrders(poly_orders);
+    fresh_GMLS.addTargets(lro);
+    fresh_GMLS.setWeightingType(WeightingFunctionType::Power);
+    fresh_GMLS.setWeightingPower(2);
+    fresh_GMLS.generateAlphas(number_of_batches);
+
+    // generate alphas for all target sites with each order
+    timer.reset();
+    GMLS low_order_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    GMLS high_order_GMLS(high_order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    std::vector<GMLS*> reference_GMLS = {&low_order_GMLS, &high_order_GMLS};
+    for (auto gmls : reference_GMLS) {
+        gmls->setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+        gmls->addTargets(lro);
+        gmls->setWeightingType(WeightingFunctionType::Power);
+        gmls->setWeightingPower(2);
+        gmls->generateAlphas(number_of_batches);
+    }
+    std::cout << "Took " << timer.seconds() << "s to generate alphas for all target sites with each order." << std::endl;
+
+    Evaluator gmls_evaluator(&my_GMLS);
+    auto output_value = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto output_laplacian = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto output_gradient = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    std::vector<decltype(output_value)> reference_value, reference_laplacian;
+    std::vector<decltype(output_gradient)> reference_gradient;
+    for (auto gmls : reference_GMLS) {
+        Evaluator reference_evaluator(gmls);
+        reference_value.push_back(reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+                (sampling_data_device, ScalarPointEvaluation));
+        reference_laplacian.push_back(reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+                (sampling_data_device, LaplacianOfScalarPointEvaluation));
+        reference_gradient.push_back(reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+                (sampling_data_device, GradientOfScalarPointEvaluation));
+    }
+
+    Evaluator fresh_evaluator(&fresh_GMLS);
+    auto fresh_value = fresh_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto fresh_laplacian = fresh_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto fresh_gradient = fresh_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    // check each target site against the reference with its order, and against alphas generated with the orders
+    // after regeneration (comparisons are written so that NaN fails)
+    for (int i=0; i<number_target_coords; i++) {
+        const int r = (poly_orders(i) == order) ? 0 : 1;
+        all_passed &= compareReconstructionsAtTarget(i, dimension, failure_tolerance, output_value, reference_value[r],
+                output_laplacian, reference_laplacian[r], output_gradient, reference_gradient[r]);
+        all_passed &= compareReconstructionsAtTarget(i, dimension, failure_tolerance, output_value, fresh_value,
+                output_laplacian, fresh_laplacian, output_gradient, fresh_gradient);
+    }
+
+    // target sites of the higher order reproduce the sampled polynomial exactly
+    for (int i=0; i<number_target_coords; i++) {
+        if (poly_orders(i) != high_order) continue;
+        double xval = target_coords(i,0);
+        double yval = (dimension>1) ? target_coords(i,1) : 0;
+        double zval = (dimension>2) ? target_coords(i,2) : 0;
+        const double actual_value = trueSolution(xval, yval, zval, high_order, dimension);
+        if (!(std::abs(output_value(i) - actual_value) <= failure_tolerance*std::max(1.0, std::abs(actual_value)))) {
+            all_passed = false;
+            std::cout << i << " Failed to reproduce polynomial of order " << high_order << " by: "
+                << std::abs(output_value(i) - actual_value) << std::endl;
+        }
+    }
+
+} // end of code block to reduce scope, causing Kokkos View de-allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+
+// finalize Kokkos and MPI (if available)
+Kokkos::finalize();
+#ifdef COMPADRE_USE_MPI
+MPI_Finalize();
+#endif
+
+// output to user that test passed or failed
+if(all_passed) {
+    fprintf(stdout, "Passed test \n");
+    return 0;
+} else {
+    fprintf(stdout, "Failed test \n");
+    return -1;
+}
+
+} // main
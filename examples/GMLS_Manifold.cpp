@@ -292,6 +292,9 @@ Kokkos::initialize(argc, args);
     
     // power to use in that weighting kernel function
     my_GMLS_scalar.setWeightingPower(2);
+
+    // group target sites with similar numbers of neighbors together when solving
+    my_GMLS_scalar.setNumberOfNeighborBuckets(clp.number_of_neighbor_buckets);
     
     // generate the alphas that to be combined with data for each target operation requested in lro
     my_GMLS_scalar.generateAlphas();
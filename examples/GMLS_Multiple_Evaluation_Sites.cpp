@@ -288,9 +288,10 @@ bool all_passed = true;
     my_GMLS.setAdditionalEvaluationSitesData(additional_target_indices_device, additional_target_coords_device);
     
     // create a vector of target operations
-    std::vector<TargetOperation> lro(2);
+    std::vector<TargetOperation> lro(3);
     lro[0] = ScalarPointEvaluation;
     lro[1] = GradientOfScalarPointEvaluation;
+    lro[2] = PartialXOfScalarPointEvaluation;
     
     // and then pass them to the GMLS class
     my_GMLS.addTargets(lro);
@@ -334,6 +335,10 @@ bool all_passed = true;
             (sampling_data_device, GradientOfScalarPointEvaluation, PointSample, 
              true /*scalar_as_vector_if_needed*/, 1 /*evaluation site index*/);
 
+    auto output_partialx1 = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, PartialXOfScalarPointEvaluation, PointSample, 
+             true /*scalar_as_vector_if_needed*/, 1 /*evaluation site index*/);
+
     auto output_value2 = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
             (sampling_data_device, ScalarPointEvaluation, PointSample, 
              true /*scalar_as_vector_if_needed*/, 2 /*evaluation site index*/);
@@ -419,6 +424,14 @@ bool all_passed = true;
                 std::cout << i << " Failed Actual by: " << std::abs(actual_value - GMLS_value) << " for evaluation site: " << k << std::endl;
             }
     
+            // check partial x (only evaluated at the first additional evaluation site)
+            if (k==0) {
+                if(!(std::abs(actual_Gradient[0] - output_partialx1(i)) <= failure_tolerance)) {
+                    all_passed = false;
+                    std::cout << i << " Failed PartialX by: " << std::abs(actual_Gradient[0] - output_partialx1(i)) << " for evaluation site: " << k << std::endl;
+                }
+            }
+
             // check gradient
             if(std::abs(actual_Gradient[0] - GMLS_GradX) > failure_tolerance) {
                 all_passed = false;
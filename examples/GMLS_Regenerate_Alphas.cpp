@@ -0,0 +1,273 @@
+/*
+ *
+ * This example tests regenerating alphas for a subset of target sites whose
+ * coordinates (and therefore neighbor lists) changed, compared against
+ * generating alphas for all target sites with a new GMLS class instance. Host
+ * copies of alphas are made lazily, so they must also reflect regenerated alphas.
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdlib.h>
+#include <cstdio>
+#include <random>
+
+#include <Compadre_Config.h>
+#include <Compadre_GMLS.hpp>
+#include <Compadre_Evaluator.hpp>
+#include <Compadre_PointCloudSearch.hpp>
+
+#include "GMLS_Tutorial.hpp"
+#include "CommandLineProcessor.hpp"
+
+#ifdef COMPADRE_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <Kokkos_Timer.hpp>
+#include <Kokkos_Core.hpp>
+
+using namespace Compadre;
+
+// fills neighbor lists and window sizes for target_coords from a kd-tree search of source_coords
+template <typename point_cloud_search_type>
+void searchNeighbors(point_cloud_search_type& point_cloud_search, Kokkos::View<double**>::HostMirror target_coords,
+        Kokkos::View<int*>& neighbor_lists_device, Kokkos::View<int*>& number_of_neighbors_list_device,
+        Kokkos::View<double*>& epsilon_device, const int min_neighbors) {
+
+    double epsilon_multiplier = 1.4;
+    const int number_target_coords = target_coords.extent(0);
+
+    Kokkos::View<int*>::HostMirror neighbor_lists("neighbor lists", 0);
+    Kokkos::View<int*>::HostMirror number_of_neighbors_list("number of neighbor lists", number_target_coords);
+    Kokkos::View<double*>::HostMirror epsilon("h supports", number_target_coords);
+
+    // dry run to calculate neighborhood sizes, then store neighbor lists
+    size_t storage_size = point_cloud_search.generateCRNeighborListsFromKNNSearch(true /*dry run*/, target_coords, neighbor_lists,
+            number_of_neighbors_list, epsilon, min_neighbors, epsilon_multiplier);
+    neighbor_lists = Kokkos::View<int*>::HostMirror("neighbor lists", storage_size);
+    point_cloud_search.generateCRNeighborListsFromKNNSearch(false /*not dry run*/, target_coords, neighbor_lists,
+            number_of_neighbors_list, epsilon, min_neighbors, epsilon_multiplier);
+    Kokkos::fence();
+
+    neighbor_lists_device = Kokkos::View<int*>("neighbor lists", storage_size);
+    number_of_neighbors_list_device = Kokkos::View<int*>("number of neighbor lists", number_target_coords);
+    epsilon_device = Kokkos::View<double*>("h supports", number_target_coords);
+    Kokkos::deep_copy(neighbor_lists_device, neighbor_lists);
+    Kokkos::deep_copy(number_of_neighbors_list_device, number_of_neighbors_list);
+    Kokkos::deep_copy(epsilon_device, epsilon);
+
+}
+
+// called from command line
+int main (int argc, char* args[]) {
+
+// initializes MPI (if available) with command line arguments given
+#ifdef COMPADRE_USE_MPI
+MPI_Init(&argc, &args);
+#endif
+
+// initializes Kokkos with command line arguments given
+Kokkos::initialize(argc, args);
+
+// becomes false if the regenerated solution is not within the failure_threshold of the generated solution
+bool all_passed = true;
+
+// code block to reduce scope for all Kokkos View allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+{
+
+    CommandLineProcessor clp(argc, args);
+    auto order = clp.order;
+    auto dimension = clp.dimension;
+    auto number_target_coords = clp.number_target_coords;
+    auto constraint_name = clp.constraint_name;
+    auto solver_name = clp.solver_name;
+    auto problem_name = clp.problem_name;
+    auto number_of_batches = clp.number_of_batches;
+    auto alpha_storage_type = (clp.alpha_storage_name == "FLOAT") ? AlphaStorageType::FloatAlphas :
+        ((clp.alpha_storage_name == "INT16") ? AlphaStorageType::ScaledInt16Alphas : AlphaStorageType::DoubleAlphas);
+
+    // regenerated alphas should match generated alphas up to roundoff (both are stored in alpha_storage_type)
+    const double failure_tolerance = 1e-10;
+
+    // minimum neighbors for unisolvency is the same as the size of the polynomial basis
+    const int min_neighbors = Compadre::GMLS::getNP(order, dimension);
+
+    // approximate spacing of source sites
+    double h_spacing = 0.05;
+    int n_neg1_to_1 = 2*(1/h_spacing) + 1; // always odd
+
+    // number of source coordinate sites that will fill a box of [-1,1]x[-1,1]x[-1,1] with a spacing approximately h
+    const int number_source_coords = std::pow(n_neg1_to_1, dimension);
+
+    // coordinates of source sites
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> source_coords_device("source coordinates",
+            number_source_coords, 3);
+    Kokkos::View<double**>::HostMirror source_coords = Kokkos::create_mirror_view(source_coords_device);
+
+    // coordinates of target sites
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> target_coords_device ("target coordinates", number_target_coords, 3);
+    Kokkos::View<double**>::HostMirror target_coords = Kokkos::create_mirror_view(target_coords_device);
+
+    // fill source coordinates with a uniform grid
+    int source_index = 0;
+    double this_coord[3] = {0,0,0};
+    for (int i=-n_neg1_to_1/2; i<n_neg1_to_1/2+1; ++i) {
+        this_coord[0] = i*h_spacing;
+        for (int j=-n_neg1_to_1/2; j<n_neg1_to_1/2+1; ++j) {
+            this_coord[1] = j*h_spacing;
+            for (int k=-n_neg1_to_1/2; k<n_neg1_to_1/2+1; ++k) {
+                this_coord[2] = k*h_spacing;
+                if (dimension==3) {
+                    source_coords(source_index,0) = this_coord[0];
+                    source_coords(source_index,1) = this_coord[1];
+                    source_coords(source_index,2) = this_coord[2];
+                    source_index++;
+                }
+            }
+            if (dimension==2) {
+                source_coords(source_index,0) = this_coord[0];
+                source_coords(source_index,1) = this_coord[1];
+                source_coords(source_index,2) = 0;
+                source_index++;
+            }
+        }
+        if (dimension==1) {
+            source_coords(source_index,0) = this_coord[0];
+            source_coords(source_index,1) = 0;
+            source_coords(source_index,2) = 0;
+            source_index++;
+        }
+    }
+
+    // fill target coords somewhere inside of [-0.5,0.5]x[-0.5,0.5]x[-0.5,0.5]
+    // (seeded, so that the same target sites are moved and regenerated in every run)
+    std::mt19937 rng(50);
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    for(int i=0; i<number_target_coords; i++){
+        for (int j=0; j<dimension; ++j) {
+            target_coords(i,j) = uniform(rng);
+        }
+    }
+    Kokkos::deep_copy(source_coords_device, source_coords);
+    Kokkos::deep_copy(target_coords_device, target_coords);
+
+    // need Kokkos View storing true solution
+    Kokkos::View<double*, Kokkos::DefaultExecutionSpace> sampling_data_device("samples of true solution",
+            source_coords_device.extent(0));
+    Kokkos::parallel_for("Sampling Manufactured Solutions", Kokkos::RangePolicy<Kokkos::DefaultExecutionSpace>
+            (0,source_coords.extent(0)), KOKKOS_LAMBDA(const int i) {
+        double xval = source_coords_device(i,0);
+        double yval = (dimension>1) ? source_coords_device(i,1) : 0;
+        double zval = (dimension>2) ? source_coords_device(i,2) : 0;
+        sampling_data_device(i) = trueSolution(xval, yval, zval, order, dimension);
+    });
+
+    auto point_cloud_search(CreatePointCloudSearch(source_coords, dimension));
+
+    Kokkos::View<int*> neighbor_lists_device, number_of_neighbors_list_device;
+    Kokkos::View<double*> epsilon_device;
+    searchNeighbors(point_cloud_search, target_coords, neighbor_lists_device, number_of_neighbors_list_device,
+            epsilon_device, min_neighbors);
+
+    std::vector<TargetOperation> lro(3);
+    lro[0] = ScalarPointEvaluation;
+    lro[1] = LaplacianOfScalarPointEvaluation;
+    lro[2] = GradientOfScalarPointEvaluation;
+
+    // generate alphas for all target sites
+    GMLS my_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    my_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    my_GMLS.addTargets(lro);
+    my_GMLS.setWeightingType(WeightingFunctionType::Power);
+    my_GMLS.setWeightingPower(2);
+    my_GMLS.setAlphaStorageType(alpha_storage_type);
+    // alphas are copied to the host only when requested
+    my_GMLS.setLazyHostAlphas(true);
+    my_GMLS.generateAlphas(number_of_batches);
+    my_GMLS.syncAlphasToHost();
+
+    // move every tenth target site, which changes its neighbor list (and usually its number of neighbors)
+    std::vector<int> dirty_target_indices;
+    for (int i=0; i<number_target_coords; i+=10) {
+        for (int j=0; j<dimension; ++j) {
+            target_coords(i,j) += 0.5*h_spacing*uniform(rng);
+        }
+        dirty_target_indices.push_back(i);
+    }
+    Kokkos::deep_copy(target_coords_device, target_coords);
+    searchNeighbors(point_cloud_search, target_coords, neighbor_lists_device, number_of_neighbors_list_device,
+            epsilon_device, min_neighbors);
+
+    // regenerate alphas only for the target sites that moved
+    Kokkos::Timer timer;
+    my_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    my_GMLS.regenerateAlphas(dirty_target_indices, number_of_batches);
+    std::cout << "Took " << timer.seconds() << "s to regenerate alphas for " << dirty_target_indices.size() << " target sites." << std::endl;
+
+    // generate alphas for all target sites at their new coordinates
+    timer.reset();
+    GMLS reference_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    reference_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    reference_GMLS.addTargets(lro);
+    reference_GMLS.setWeightingType(WeightingFunctionType::Power);
+    reference_GMLS.setWeightingPower(2);
+    reference_GMLS.setAlphaStorageType(alpha_storage_type);
+    reference_GMLS.generateAlphas(number_of_batches);
+    std::cout << "Took " << timer.seconds() << "s to generate alphas for " << number_target_coords << " target sites." << std::endl;
+
+    Evaluator gmls_evaluator(&my_GMLS);
+    Evaluator reference_evaluator(&reference_GMLS);
+
+    auto output_value = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto output_laplacian = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto output_gradient = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    auto reference_value = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto reference_laplacian = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto reference_gradient = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    // check that regenerated alphas (and moved alphas of target sites not regenerated) match
+    for (int i=0; i<number_target_coords; i++) {
+        all_passed &= compareReconstructionsAtTarget(i, dimension, failure_tolerance, output_value, reference_value,
+                output_laplacian, reference_laplacian, output_gradient, reference_gradient);
+        // host copy of regenerated alphas, made on first access after regenerateAlphas
+        for (int j=0; j<my_GMLS.getNeighborLists()->getNumberOfNeighborsHost(i); ++j) {
+            double alpha = my_GMLS.getAlpha0TensorTo0Tensor(LaplacianOfScalarPointEvaluation, i, j);
+            double reference_alpha = reference_GMLS.getAlpha0TensorTo0Tensor(LaplacianOfScalarPointEvaluation, i, j);
+            if (std::abs(alpha - reference_alpha) > failure_tolerance*std::max(1.0, std::abs(reference_alpha))) {
+                all_passed = false;
+                std::cout << i << " Failed host alpha for neighbor " << j << " by: " << std::abs(alpha - reference_alpha) << std::endl;
+            }
+        }
+    }
+
+} // end of code block to reduce scope, causing Kokkos View de-allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+
+// finalize Kokkos and MPI (if available)
+Kokkos::finalize();
+#ifdef COMPADRE_USE_MPI
+MPI_Finalize();
+#endif
+
+// output to user that test passed or failed
+if(all_passed) {
+    fprintf(stdout, "Passed test \n");
+    return 0;
+} else {
+    fprintf(stdout, "Failed test \n");
+    return -1;
+}
+
+} // main
@@ -0,0 +1,215 @@
+/*
+ *
+ * This example tests generating alphas with stencil deduplication, where target sites whose
+ * neighborhoods are translations and scalings of another target site's neighborhood (listed
+ * in any order) have their alphas copied from that target site rather than solved for,
+ * compared against generating alphas for all target sites without deduplication.
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdlib.h>
+#include <cstdio>
+#include <random>
+
+#include <Compadre_Config.h>
+#include <Compadre_GMLS.hpp>
+#include <Compadre_Evaluator.hpp>
+
+#include "GMLS_Tutorial.hpp"
+#include "CommandLineProcessor.hpp"
+
+#ifdef COMPADRE_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <Kokkos_Timer.hpp>
+#include <Kokkos_Core.hpp>
+
+using namespace Compadre;
+
+// called from command line
+int main (int argc, char* args[]) {
+
+// initializes MPI (if available) with command line arguments given
+#ifdef COMPADRE_USE_MPI
+MPI_Init(&argc, &args);
+#endif
+
+// initializes Kokkos with command line arguments given
+Kokkos::initialize(argc, args);
+
+// becomes false if the deduplicated solution is not within the failure_threshold of the reference solution
+bool all_passed = true;
+
+// code block to reduce scope for all Kokkos View allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+{
+
+    CommandLineProcessor clp(argc, args);
+    auto order = clp.order;
+    auto dimension = clp.dimension;
+    auto number_target_coords = clp.number_target_coords;
+    auto constraint_name = clp.constraint_name;
+    auto solver_name = clp.solver_name;
+    auto problem_name = clp.problem_name;
+    auto number_of_batches = clp.number_of_batches;
+
+    // copied alphas should match solved alphas up to roundoff
+    const double failure_tolerance = 1e-8;
+
+    // relative coordinates are rounded to this spacing (relative to epsilon) when comparing neighborhoods
+    const double deduplication_tolerance = 1e-8;
+
+    // each neighborhood has twice as many neighbors as the size of the polynomial basis
+    const int number_of_neighbors = 2*Compadre::GMLS::getNP(order, dimension);
+
+    // a few neighborhood patterns in [-1,1]^dimension are shared by most target sites, scaled by one of
+    // several factors, while every seventh target site has a neighborhood of its own
+    const int number_of_patterns = 3;
+    const double scales[4] = {1.0, 0.5, 2.0, 0.25};
+    std::mt19937 rng(50);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    auto random_pattern = [&]() {
+        std::vector<double> pattern(number_of_neighbors*3, 0);
+        for (int j=0; j<number_of_neighbors; ++j) {
+            for (int d=0; d<dimension; ++d) pattern[j*3+d] = uniform(rng);
+        }
+        return pattern;
+    };
+    std::vector<std::vector<double> > patterns;
+    for (int p=0; p<number_of_patterns; ++p) patterns.push_back(random_pattern());
+
+    // coordinates of target sites, and of a separate set of source sites for each target site
+    const int number_source_coords = number_target_coords*number_of_neighbors;
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> source_coords_device("source coordinates",
+            number_source_coords, 3);
+    Kokkos::View<double**>::HostMirror source_coords = Kokkos::create_mirror_view(source_coords_device);
+    Kokkos::View<double**, Kokkos::DefaultExecutionSpace> target_coords_device("target coordinates",
+            number_target_coords, 3);
+    Kokkos::View<double**>::HostMirror target_coords = Kokkos::create_mirror_view(target_coords_device);
+    Kokkos::View<int*> neighbor_lists_device("neighbor lists", number_source_coords);
+    Kokkos::View<int*>::HostMirror neighbor_lists = Kokkos::create_mirror_view(neighbor_lists_device);
+    Kokkos::View<int*> number_of_neighbors_list_device("number of neighbor lists", number_target_coords);
+    Kokkos::View<int*>::HostMirror number_of_neighbors_list = Kokkos::create_mirror_view(number_of_neighbors_list_device);
+    Kokkos::View<double*> epsilon_device("h supports", number_target_coords);
+    Kokkos::View<double*>::HostMirror epsilon = Kokkos::create_mirror_view(epsilon_device);
+
+    int number_of_unique_neighborhoods = number_of_patterns;
+    for (int i=0; i<number_target_coords; ++i) {
+        for (int d=0; d<dimension; ++d) target_coords(i,d) = 0.5*uniform(rng);
+
+        const bool unique_neighborhood = (i%7 == 6);
+        if (unique_neighborhood) number_of_unique_neighborhoods++;
+        const std::vector<double> pattern = (unique_neighborhood) ? random_pattern() : patterns[i%number_of_patterns];
+        const double scale = scales[i%4];
+
+        // epsilon covers every point of the pattern, and scales with it
+        epsilon(i) = scale*1.5*std::sqrt((double)dimension);
+        number_of_neighbors_list(i) = number_of_neighbors;
+        for (int j=0; j<number_of_neighbors; ++j) {
+            const int source_index = i*number_of_neighbors + j;
+            for (int d=0; d<dimension; ++d) {
+                source_coords(source_index,d) = target_coords(i,d) + scale*pattern[j*3+d];
+            }
+            // odd target sites list their neighbors in reverse order
+            neighbor_lists(source_index) = (i%2 == 1) ? i*number_of_neighbors + (number_of_neighbors-1-j) : source_index;
+        }
+    }
+    Kokkos::deep_copy(source_coords_device, source_coords);
+    Kokkos::deep_copy(target_coords_device, target_coords);
+    Kokkos::deep_copy(neighbor_lists_device, neighbor_lists);
+    Kokkos::deep_copy(number_of_neighbors_list_device, number_of_neighbors_list);
+    Kokkos::deep_copy(epsilon_device, epsilon);
+
+    // need Kokkos View storing true solution
+    Kokkos::View<double*, Kokkos::DefaultExecutionSpace> sampling_data_device("samples of true solution",
+            source_coords_device.extent(0));
+    Kokkos::parallel_for("Sampling Manufactured Solutions", Kokkos::RangePolicy<Kokkos::DefaultExecutionSpace>
+            (0,source_coords.extent(0)), KOKKOS_LAMBDA(const int i) {
+        double xval = source_coords_device(i,0);
+        double yval = (dimension>1) ? source_coords_device(i,1) : 0;
+        double zval = (dimension>2) ? source_coords_device(i,2) : 0;
+        sampling_data_device(i) = trueSolution(xval, yval, zval, order, dimension);
+    });
+
+    std::vector<TargetOperation> lro(3);
+    lro[0] = ScalarPointEvaluation;
+    lro[1] = LaplacianOfScalarPointEvaluation;
+    lro[2] = GradientOfScalarPointEvaluation;
+
+    // generate alphas, solving only one target site of each set of equivalent neighborhoods
+    Kokkos::Timer timer;
+    GMLS my_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    my_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    my_GMLS.addTargets(lro);
+    my_GMLS.setWeightingType(WeightingFunctionType::Power);
+    my_GMLS.setWeightingPower(2);
+    my_GMLS.setStencilDeduplicationTolerance(deduplication_tolerance);
+    my_GMLS.generateAlphas(number_of_batches);
+    std::cout << "Took " << timer.seconds() << "s to generate alphas with deduplication." << std::endl;
+
+    // generate alphas for all target sites
+    timer.reset();
+    GMLS reference_GMLS(order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2 /*manifold order*/);
+    reference_GMLS.setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, target_coords_device, epsilon_device);
+    reference_GMLS.addTargets(lro);
+    reference_GMLS.setWeightingType(WeightingFunctionType::Power);
+    reference_GMLS.setWeightingPower(2);
+    reference_GMLS.generateAlphas(number_of_batches);
+    std::cout << "Took " << timer.seconds() << "s to generate alphas without deduplication." << std::endl;
+
+    // every target site not having a neighborhood of its own is copied, except for one per pattern
+    const int expected_deduplicated_targets = number_target_coords - number_of_unique_neighborhoods;
+    std::cout << my_GMLS.getNumberOfDeduplicatedTargets() << " of " << number_target_coords
+        << " target sites had alphas copied from an equivalent neighborhood." << std::endl;
+    if (my_GMLS.getNumberOfDeduplicatedTargets() != expected_deduplicated_targets) {
+        all_passed = false;
+        std::cout << "Failed to find " << expected_deduplicated_targets << " target sites with equivalent neighborhoods." << std::endl;
+    }
+
+    Evaluator gmls_evaluator(&my_GMLS);
+    Evaluator reference_evaluator(&reference_GMLS);
+
+    auto output_value = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto output_laplacian = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto output_gradient = gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    auto reference_value = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, ScalarPointEvaluation);
+    auto reference_laplacian = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, Kokkos::HostSpace>
+            (sampling_data_device, LaplacianOfScalarPointEvaluation);
+    auto reference_gradient = reference_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, Kokkos::HostSpace>
+            (sampling_data_device, GradientOfScalarPointEvaluation);
+
+    // check that copied and rescaled alphas match solved alphas (comparisons are written so that NaN fails)
+    for (int i=0; i<number_target_coords; i++) {
+        all_passed &= compareReconstructionsAtTarget(i, dimension, failure_tolerance, output_value, reference_value,
+                output_laplacian, reference_laplacian, output_gradient, reference_gradient);
+    }
+
+} // end of code block to reduce scope, causing Kokkos View de-allocations
+// otherwise, Views may be deallocating when we call Kokkos::finalize() later
+
+// finalize Kokkos and MPI (if available)
+Kokkos::finalize();
+#ifdef COMPADRE_USE_MPI
+MPI_Finalize();
+#endif
+
+// output to user that test passed or failed
+if(all_passed) {
+    fprintf(stdout, "Passed test \n");
+    return 0;
+} else {
+    fprintf(stdout, "Failed test \n");
+    return -1;
+}
+
+} // main
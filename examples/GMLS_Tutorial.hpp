@@ -1,6 +1,7 @@
 #ifndef _GMLS_TUTORIAL_HPP_
 #define _GMLS_TUTORIAL_HPP_
 
+#include <iostream>
 #include <Kokkos_Core.hpp>
 #include <basis/Compadre_DivergenceFreePolynomial.hpp>
 #include <Compadre_GMLS.hpp>
@@ -418,6 +419,35 @@ double gradientdivfreeTestSolution_span_basis(double x, double y, double z, int
     return val;
 }
 
+//! Compares value, Laplacian, and gradient reconstructions at target site i against reference reconstructions.
+//! Prints each quantity whose relative difference exceeds tolerance and returns false if any did.
+//! Comparisons are written so that NaN fails.
+template <typename ValueView, typename GradientView>
+bool compareReconstructionsAtTarget(const int i, const int dimension, const double tolerance,
+        ValueView value, ValueView reference_value, ValueView laplacian, ValueView reference_laplacian,
+        GradientView gradient, GradientView reference_gradient) {
+    auto relative_difference = [](const double a, const double b) {
+        return std::abs(a - b) / std::max(1.0, std::abs(b));
+    };
+    bool passed = true;
+    if (!(relative_difference(value(i), reference_value(i)) <= tolerance)) {
+        passed = false;
+        std::cout << i << " Failed Value by: " << relative_difference(value(i), reference_value(i)) << std::endl;
+    }
+    if (!(relative_difference(laplacian(i), reference_laplacian(i)) <= tolerance)) {
+        passed = false;
+        std::cout << i << " Failed Laplacian by: " << relative_difference(laplacian(i), reference_laplacian(i)) << std::endl;
+    }
+    for (int j=0; j<dimension; ++j) {
+        if (!(relative_difference(gradient(i,j), reference_gradient(i,j)) <= tolerance)) {
+            passed = false;
+            std::cout << i << " Failed Gradient component " << j << " by: "
+                << relative_difference(gradient(i,j), reference_gradient(i,j)) << std::endl;
+        }
+    }
+    return passed;
+}
+
 /** Standard GMLS Example 
  *
  *  Exercises GMLS operator evaluation with data over various orders and numbers of targets for targets including point evaluation, Laplacian, divergence, curl, and gradient.
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <cstdio>
+#include <climits>
+#include <random>
+
+#include <Compadre_Config.h>
+#include <Compadre_LinearAlgebra_Definitions.hpp>
+#include <Compadre_KokkosParser.hpp>
+
+#include "CommandLineProcessor.hpp"
+
+#ifdef COMPADRE_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <Kokkos_Timer.hpp>
+#include <Kokkos_Core.hpp>
+
+using namespace Compadre;
+
+// Compares the unblocked and blocked QR+Pivoting factorizations used by batchQRPivotingSolve
+// over (M x N) shapes typical of GMLS problems, where N is the size of the polynomial basis
+// and M is the number of neighbors. Right hand sides are diagonal, as in the GMLS QR path.
+
+// called from command line
+int main (int argc, char* args[]) {
+
+// initializes MPI (if available) with command line arguments given
+#ifdef COMPADRE_USE_MPI
+MPI_Init(&argc, &args);
+#endif
+
+// initializes Kokkos with command line arguments given
+auto kp = KokkosParser(argc, args, true);
+
+// becomes false if the blocked and unblocked solutions differ
+bool all_passed = true;
+
+// code block to reduce scope for all Kokkos View allocations
+// otherwise, Views may be deallocating when we call Kokkos finalize() later
+{
+
+    CommandLineProcessor clp(argc, args, false /* print */);
+
+    // number of matrices in each batch
+    const int num_matrices = clp.number_target_coords;
+    // number of times each solve is repeated for timing
+    const int num_repetitions = 3;
+
+    // (N, M) for 1D order 4, 2D orders 2 and 4, and 3D orders 2 through 5
+    std::vector<std::pair<int,int> > shapes = { {5,12}, {6,20}, {15,45}, {10,40}, {20,75}, {35,120}, {56,180} };
+
+    std::mt19937 rng(50);
+    std::uniform_real_distribution<double> entry_distribution(-1.0, 1.0);
+    std::uniform_real_distribution<double> weight_distribution(0.1, 1.0);
+
+    const double failure_tolerance = 1e-9;
+
+    ParallelManager pm;
+
+    std::cout << std::setw(6) << "M" << std::setw(6) << "N"
+        << std::setw(16) << "unblocked (s)" << std::setw(16) << "blocked (s)"
+        << std::setw(12) << "speedup" << std::setw(16) << "max rel diff" << std::endl;
+
+    for (auto shape : shapes) {
+        const int N = shape.first;
+        const int M = shape.second;
+
+        // A is (M x N), B is (N x M) with a diagonal stored in its first M entries
+        Kokkos::View<double*, host_execution_space> A("A", M*N*num_matrices);
+        Kokkos::View<double*, host_execution_space> B("B", N*M*num_matrices);
+        for (int k=0; k<num_matrices; ++k) {
+            for (int i=0; i<M*N; ++i) A(k*M*N + i) = entry_distribution(rng);
+            for (int i=0; i<M; ++i) B(k*N*M + i) = std::sqrt(weight_distribution(rng));
+        }
+
+        Kokkos::View<double*, device_execution_space> A_d("A device", M*N*num_matrices);
+        Kokkos::View<double*, device_execution_space> B_d("B device", N*M*num_matrices);
+
+        double timings[2] = {0, 0};
+        Kokkos::View<double*, host_execution_space> X[2];
+        // unblocked is forced by a threshold that is never reached, blocked by a threshold of 0
+        const int blocked_thresholds[2] = {INT_MAX, 0};
+
+        for (int algo=0; algo<2; ++algo) {
+            for (int rep=0; rep<num_repetitions; ++rep) {
+                Kokkos::deep_copy(A_d, A);
+                Kokkos::deep_copy(B_d, B);
+                Kokkos::fence();
+
+                Kokkos::Timer timer;
+                GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm,
+                        A_d.data(), M, N, B_d.data(), N, M, M, N, M, num_matrices, blocked_thresholds[algo]);
+                Kokkos::fence();
+                const double elapsed = timer.seconds();
+                timings[algo] = (rep==0 || elapsed < timings[algo]) ? elapsed : timings[algo];
+            }
+            X[algo] = Kokkos::View<double*, host_execution_space>("X", N*M*num_matrices);
+            Kokkos::deep_copy(X[algo], B_d);
+        }
+
+        double max_abs_X = 0, max_abs_diff = 0;
+        for (int i=0; i<N*M*num_matrices; ++i) {
+            max_abs_X = std::max(max_abs_X, std::abs(X[0](i)));
+            max_abs_diff = std::max(max_abs_diff, std::abs(X[0](i) - X[1](i)));
+        }
+        const double max_rel_diff = (max_abs_X > 0) ? max_abs_diff / max_abs_X : max_abs_diff;
+        if (!(max_rel_diff < failure_tolerance)) {
+            all_passed = false;
+        }
+
+        std::cout << std::setw(6) << M << std::setw(6) << N
+            << std::setw(16) << timings[0] << std::setw(16) << timings[1]
+            << std::setw(12) << timings[0]/timings[1] << std::setw(16) << max_rel_diff << std::endl;
+    }
+
+} // end of code block to reduce scope, causing Kokkos View de-allocations
+// otherwise, Views may be deallocating when we call Kokkos finalize() later
+
+// finalize Kokkos and MPI (if available)
+kp.finalize();
+#ifdef COMPADRE_USE_MPI
+MPI_Finalize();
+#endif
+
+// output to user that test passed or failed
+if(all_passed) {
+    fprintf(stdout, "Passed test \n");
+    return 0;
+} else {
+    fprintf(stdout, "Failed test \n");
+    return -1;
+}
+
+} // main
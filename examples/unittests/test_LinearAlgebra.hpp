@@ -5,6 +5,7 @@
 #include "Compadre_LinearAlgebra_Declarations.hpp"
 #include <gtest/gtest.h>
 #include <cmath>
+#include <climits>
 
 using namespace Compadre;
 
@@ -671,6 +672,190 @@ TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Larger_LDB_NDB_L
     EXPECT_NEAR(-0.803571428571429, B2(2,3), 1e-14);
 }
 
+//
+// Square Symmetric Positive Definite Tests
+// Tested for A=LayoutRight (LRA), B=LayoutLeft (LLB), X=LayoutRight (LRX), as used for P^T*W*P
+//
+// A is negated after setup so that it is positive definite
+//
+
+TEST_F (LinearAlgebraTest, Square_SPD_batchCholeskySolve_Same_LDA_NDA_LRA_LLB_LRX) {
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    for (size_t i=0; i<A.extent(0); ++i) A(i) = -A(i);
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                   0   0.071428571428571   0.035714285714286
+    //                   0   0.285714285714286   0.142857142857143
+    //                   0   0.071428571428571   0.535714285714286
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR( 0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR( 0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR( 0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR( 0.535714285714286, B2(2,2), 1e-14);
+}
+
+TEST_F (LinearAlgebraTest, Square_SPD_batchCholeskySolve_Larger_LDA_NDA_Larger_NRHS_LRA_LLB_LRX) {
+    // lda and nda larger than M and N
+    int M=3, N=3, NRHS=4, num_matrices=2, rank=3;
+    int lda=7, nda=12;
+    int ldb=3, ndb=4;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    for (size_t i=0; i<A.extent(0); ++i) A(i) = -A(i);
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                  0   0.071428571428571   0.035714285714286   0.053571428571429
+    //                  0   0.285714285714286   0.142857142857143   0.214285714285714
+    //                  0   0.071428571428571   0.535714285714286   0.803571428571429
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR( 0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR( 0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR( 0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR( 0.535714285714286, B2(2,2), 1e-14);
+    EXPECT_NEAR( 0.053571428571429, B2(0,3), 1e-14);
+    EXPECT_NEAR( 0.214285714285714, B2(1,3), 1e-14);
+    EXPECT_NEAR( 0.803571428571429, B2(2,3), 1e-14);
+}
+
+TEST_F (LinearAlgebraTest, Square_NotSPD_batchCholeskySolve_Falls_Back_To_QR_LRA_LLB_LRX) {
+    // A is negative definite, so it is solved with QR+Pivoting
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                   0  -0.071428571428571  -0.035714285714286
+    //                   0  -0.285714285714286  -0.142857142857143
+    //                   0  -0.071428571428571  -0.535714285714286
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR(-0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR(-0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR(-0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR(-0.535714285714286, B2(2,2), 1e-14);
+}
+
+TEST_F (LinearAlgebraTest, Square_SPD_batchCholeskySolve_Mixed_Precision_LRA_LLB_LRX) {
+    // factored in single precision, refined to double precision accuracy
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    for (size_t i=0; i<A.extent(0); ++i) A(i) = -A(i);
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices, true /*factor_in_single_precision*/);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                   0   0.071428571428571   0.035714285714286
+    //                   0   0.285714285714286   0.142857142857143
+    //                   0   0.071428571428571   0.535714285714286
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR( 0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR( 0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR( 0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR( 0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR( 0.535714285714286, B2(2,2), 1e-14);
+}
+
+TEST_F (LinearAlgebraTest, Square_NotSPD_batchCholeskySolve_Mixed_Precision_Falls_Back_To_QR_LRA_LLB_LRX) {
+    // A is negative definite, so it fails in single and double precision and is solved with QR+Pivoting
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices, true /*factor_in_single_precision*/);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                   0  -0.071428571428571  -0.035714285714286
+    //                   0  -0.285714285714286  -0.142857142857143
+    //                   0  -0.071428571428571  -0.535714285714286
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR(-0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR(-0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR(-0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR(-0.535714285714286, B2(2,2), 1e-14);
+}
+
+//
+// Blocked QR+Pivoting Tests
+// Blocked factorization (blocked_threshold=0) compared against unblocked (blocked_threshold=INT_MAX)
+//
+
+TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Blocked_Matches_Unblocked_LRA_LRB_LRX) {
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, M, N, NRHS, num_matrices, INT_MAX);
+    Kokkos::View<double*, host_execution_space> X_unblocked("X unblocked", B.extent(0));
+    Kokkos::deep_copy(X_unblocked, B_d);
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, M, N, NRHS, num_matrices, 0);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    for (size_t i=0; i<B.extent(0); ++i) {
+        EXPECT_NEAR(X_unblocked(i), B(i), 1e-14);
+    }
+}
+
+TEST_F (LinearAlgebraTest, Square_RankDeficient_batchQRPivotingSolve_Blocked_Matches_Unblocked_LRA_LRB_LRX) {
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=2;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, M, N, NRHS, num_matrices, INT_MAX);
+    Kokkos::View<double*, host_execution_space> X_unblocked("X unblocked", B.extent(0));
+    Kokkos::deep_copy(X_unblocked, B_d);
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, M, N, NRHS, num_matrices, 0);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    for (size_t i=0; i<B.extent(0); ++i) {
+        EXPECT_NEAR(X_unblocked(i), B(i), 1e-14);
+    }
+}
+
 //LLX!TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Same_LDA_NDA_LRA_LLB_LLX) {
 //LLX!    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
 //LLX!    int lda=3, nda=3;
@@ -157,23 +157,26 @@ public:
         
         // gather needed information for evaluation
         auto nla = *(_gmls->getNeighborLists());
-        auto alphas = _gmls->getAlphas();
         auto sampling_data_device = sampling_subview_maker.get1DView(column_of_input);
         
         auto alpha_index = _gmls->getAlphaIndexHost(target_index, alpha_input_output_component_index);
-        // loop through neighbor list for this target_index
-        // grabbing data from that entry of data
-        Kokkos::parallel_reduce("applyAlphasToData::Device", 
-                Kokkos::RangePolicy<device_execution_space>(0,nla.getNumberOfNeighborsHost(target_index)), 
-                KOKKOS_LAMBDA(const int i, double& t_value) {
-
-            t_value += sampling_data_device(nla.getNeighborDevice(target_index, i))
-                *alphas(alpha_index + i);
-
-        }, value );
-        Kokkos::fence();
+        const double alpha_scale = _gmls->getAlphaScaleHost(target_index, alpha_input_output_component_index);
+        // storage format of alphas is resolved here, so the kernel reads them without branching
+        switch (_gmls->getStoredAlphaType()) {
+            case AlphaStorageType::FloatAlphas:
+                value = applyStoredAlphasToDataSingleTargetSite(_gmls->getFloatAlphas(), sampling_data_device, nla, 
+                        target_index, alpha_index);
+                break;
+            case AlphaStorageType::ScaledInt16Alphas:
+                value = applyStoredAlphasToDataSingleTargetSite(_gmls->getInt16Alphas(), sampling_data_device, nla, 
+                        target_index, alpha_index);
+                break;
+            default:
+                value = applyStoredAlphasToDataSingleTargetSite(_gmls->getAlphas(), sampling_data_device, nla, 
+                        target_index, alpha_index);
+        }
 
-        return value;
+        return alpha_scale*value;
     }
 
     //! Dot product of alphas with sampling data where sampling data is in a 1D/2D Kokkos View and output view is also 
@@ -204,93 +207,20 @@ public:
     template <typename view_type_data_out, typename view_type_data_in>
     void applyAlphasToDataSingleComponentAllTargetSitesWithPreAndPostTransform(view_type_data_out output_data_single_column, view_type_data_in sampling_data_single_column, TargetOperation lro, const SamplingFunctional sro, const int evaluation_site_local_index, const int output_component_axis_1, const int output_component_axis_2, const int input_component_axis_1, const int input_component_axis_2, const int pre_transform_local_index = -1, const int pre_transform_global_index = -1, const int post_transform_local_index = -1, const int post_transform_global_index = -1, bool vary_on_target = false, bool vary_on_neighbor = false) const {
 
-        const int alpha_input_output_component_index = _gmls->getAlphaColumnOffset(lro, output_component_axis_1, 
-                output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
-        const int alpha_input_output_component_index2 = alpha_input_output_component_index;
-
-        // gather needed information for evaluation
-        auto gmls = *(_gmls);
-        auto nla = *(_gmls->getNeighborLists());
-        auto alphas = _gmls->getAlphas();
-        auto prestencil_weights = _gmls->getPrestencilWeights();
-
-        const int num_targets = nla.getNumberOfTargets();
-
-        // make sure input and output views have same memory space
-        compadre_assert_debug((std::is_same<typename view_type_data_out::memory_space, typename view_type_data_in::memory_space>::value) && 
-                "output_data_single_column view and input_data_single_column view have difference memory spaces.");
-
-        bool weight_with_pre_T = (pre_transform_local_index>=0 && pre_transform_global_index>=0) ? true : false;
-        bool target_plus_neighbor_staggered_schema = sro.use_target_site_weights;
-
-        // loops over target indices
-        Kokkos::parallel_for(team_policy(num_targets, Kokkos::AUTO),
-                KOKKOS_LAMBDA(const member_type& teamMember) {
-
-            const int target_index = teamMember.league_rank();
-            teamMember.team_barrier();
-
-
-            const double previous_value = output_data_single_column(target_index);
-
-            // loops over neighbors of target_index
-            auto alpha_index = gmls.getAlphaIndexDevice(target_index, alpha_input_output_component_index);
-            double gmls_value = 0;
-            Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, nla.getNumberOfNeighborsDevice(target_index)), [=](const int i, double& t_value) {
-                const double neighbor_varying_pre_T =  (weight_with_pre_T && vary_on_neighbor) ?
-                    prestencil_weights(0, target_index, i, pre_transform_local_index, pre_transform_global_index)
-                    : 1.0;
-
-                t_value += neighbor_varying_pre_T * sampling_data_single_column(nla.getNeighborDevice(target_index, i))
-                            *alphas(alpha_index + i);
-
-            }, gmls_value );
-
-            // data contract for sampling functional
-            double pre_T = 1.0;
-            if (weight_with_pre_T) {
-                if (!vary_on_neighbor && vary_on_target) {
-                    pre_T = prestencil_weights(0, target_index, 0, pre_transform_local_index, 
-                            pre_transform_global_index); 
-                } else if (!vary_on_target) { // doesn't vary on target or neighbor
-                    pre_T = prestencil_weights(0, 0, 0, pre_transform_local_index, 
-                            pre_transform_global_index); 
-                }
-            }
-
-            double staggered_value_from_targets = 0;
-            double pre_T_staggered = 1.0;
-            auto alpha_index2 = gmls.getAlphaIndexDevice(target_index, alpha_input_output_component_index2);
-            // loops over target_index for each neighbor for staggered approaches
-            if (target_plus_neighbor_staggered_schema) {
-                Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, nla.getNumberOfNeighborsDevice(target_index)), [=](const int i, double& t_value) {
-                    const double neighbor_varying_pre_T_staggered =  (weight_with_pre_T && vary_on_neighbor) ?
-                        prestencil_weights(1, target_index, i, pre_transform_local_index, pre_transform_global_index)
-                        : 1.0;
-
-                    t_value += neighbor_varying_pre_T_staggered * sampling_data_single_column(nla.getNeighborDevice(target_index, 0))
-                                *alphas(alpha_index2 + i);
-
-                }, staggered_value_from_targets );
-
-                // for staggered approaches that transform source data for the target and neighbors
-                if (weight_with_pre_T) {
-                    if (!vary_on_neighbor && vary_on_target) {
-                        pre_T_staggered = prestencil_weights(1, target_index, 0, pre_transform_local_index, 
-                                pre_transform_global_index); 
-                    } else if (!vary_on_target) { // doesn't vary on target or neighbor
-                        pre_T_staggered = prestencil_weights(1, 0, 0, pre_transform_local_index, 
-                                pre_transform_global_index); 
-                    }
-                }
-            }
-
-            double added_value = pre_T*gmls_value + pre_T_staggered*staggered_value_from_targets;
-            Kokkos::single(Kokkos::PerTeam(teamMember), [=] () {
-                output_data_single_column(target_index) = previous_value + added_value;
-            });
-        });
-        Kokkos::fence();
+        // storage format of alphas is resolved here, so each kernel instantiation reads them without branching
+        switch (_gmls->getStoredAlphaType()) {
+            case AlphaStorageType::FloatAlphas:
+                applyStoredAlphasToDataAllTargetSites(_gmls->getFloatAlphas(), 
+                        output_data_single_column, sampling_data_single_column, lro, sro, evaluation_site_local_index, output_component_axis_1, output_component_axis_2, input_component_axis_1, input_component_axis_2, pre_transform_local_index, pre_transform_global_index, post_transform_local_index, post_transform_global_index, vary_on_target, vary_on_neighbor);
+                break;
+            case AlphaStorageType::ScaledInt16Alphas:
+                applyStoredAlphasToDataAllTargetSites(_gmls->getInt16Alphas(), 
+                        output_data_single_column, sampling_data_single_column, lro, sro, evaluation_site_local_index, output_component_axis_1, output_component_axis_2, input_component_axis_1, input_component_axis_2, pre_transform_local_index, pre_transform_global_index, post_transform_local_index, post_transform_global_index, vary_on_target, vary_on_neighbor);
+                break;
+            default:
+                applyStoredAlphasToDataAllTargetSites(_gmls->getAlphas(), 
+                        output_data_single_column, sampling_data_single_column, lro, sro, evaluation_site_local_index, output_component_axis_1, output_component_axis_2, input_component_axis_1, input_component_axis_2, pre_transform_local_index, pre_transform_global_index, post_transform_local_index, post_transform_global_index, vary_on_target, vary_on_neighbor);
+        }
     }
 
     //! Postprocessing for manifolds. Maps local chart vector solutions to ambient space.
@@ -800,6 +730,127 @@ public:
         Kokkos::deep_copy(coefficient_output, output_subview_maker.copyToAndReturnOriginalView());
     }
 
+private:
+
+    //! Sum over neighbors of target_index of sampling data times stored alphas, beginning at alpha_index, in the
+    //! storage format of stored_alphas. Result still needs to be multiplied by the alpha scale of the tile.
+    template <typename view_type_alphas, typename view_type_data, typename neighbor_lists_type>
+    double applyStoredAlphasToDataSingleTargetSite(view_type_alphas stored_alphas, view_type_data sampling_data_device, const neighbor_lists_type& nla, const int target_index, const global_index_type alpha_index) const {
+
+        double value = 0;
+        // loop through neighbor list for this target_index
+        // grabbing data from that entry of data
+        Kokkos::parallel_reduce("applyAlphasToData::Device", 
+                Kokkos::RangePolicy<device_execution_space>(0,nla.getNumberOfNeighborsHost(target_index)), 
+                KOKKOS_LAMBDA(const int i, double& t_value) {
+
+            t_value += sampling_data_device(nla.getNeighborDevice(target_index, i))
+                *stored_alphas(alpha_index + i);
+
+        }, value );
+        Kokkos::fence();
+
+        return value;
+    }
+
+    //! Implements applyAlphasToDataSingleComponentAllTargetSitesWithPreAndPostTransform for alphas stored in the
+    //! format of stored_alphas
+    template <typename view_type_alphas, typename view_type_data_out, typename view_type_data_in>
+    void applyStoredAlphasToDataAllTargetSites(view_type_alphas stored_alphas, view_type_data_out output_data_single_column, view_type_data_in sampling_data_single_column, TargetOperation lro, const SamplingFunctional sro, const int evaluation_site_local_index, const int output_component_axis_1, const int output_component_axis_2, const int input_component_axis_1, const int input_component_axis_2, const int pre_transform_local_index, const int pre_transform_global_index, const int post_transform_local_index, const int post_transform_global_index, bool vary_on_target, bool vary_on_neighbor) const {
+
+        const int alpha_input_output_component_index = _gmls->getAlphaColumnOffset(lro, output_component_axis_1, 
+                output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
+        const int alpha_input_output_component_index2 = alpha_input_output_component_index;
+
+        // gather needed information for evaluation
+        auto gmls = *(_gmls);
+        auto nla = *(_gmls->getNeighborLists());
+        auto prestencil_weights = _gmls->getPrestencilWeights();
+
+        const int num_targets = nla.getNumberOfTargets();
+
+        // make sure input and output views have same memory space
+        compadre_assert_debug((std::is_same<typename view_type_data_out::memory_space, typename view_type_data_in::memory_space>::value) && 
+                "output_data_single_column view and input_data_single_column view have difference memory spaces.");
+
+        bool weight_with_pre_T = (pre_transform_local_index>=0 && pre_transform_global_index>=0) ? true : false;
+        bool target_plus_neighbor_staggered_schema = sro.use_target_site_weights;
+
+        // loops over target indices
+        Kokkos::parallel_for(team_policy(num_targets, Kokkos::AUTO),
+                KOKKOS_LAMBDA(const member_type& teamMember) {
+
+            const int target_index = teamMember.league_rank();
+            teamMember.team_barrier();
+
+
+            const double previous_value = output_data_single_column(target_index);
+
+            // loops over neighbors of target_index
+            // alphas are read in their stored format and scaled once per target site
+            auto alpha_index = gmls.getAlphaIndexDevice(target_index, alpha_input_output_component_index);
+            const double alpha_scale = gmls.getAlphaScaleDevice(target_index, alpha_input_output_component_index);
+            double gmls_value = 0;
+            Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, nla.getNumberOfNeighborsDevice(target_index)), [=](const int i, double& t_value) {
+                const double neighbor_varying_pre_T =  (weight_with_pre_T && vary_on_neighbor) ?
+                    prestencil_weights(0, target_index, i, pre_transform_local_index, pre_transform_global_index)
+                    : 1.0;
+
+                t_value += neighbor_varying_pre_T * sampling_data_single_column(nla.getNeighborDevice(target_index, i))
+                            *stored_alphas(alpha_index + i);
+
+            }, gmls_value );
+            gmls_value *= alpha_scale;
+
+            // data contract for sampling functional
+            double pre_T = 1.0;
+            if (weight_with_pre_T) {
+                if (!vary_on_neighbor && vary_on_target) {
+                    pre_T = prestencil_weights(0, target_index, 0, pre_transform_local_index, 
+                            pre_transform_global_index); 
+                } else if (!vary_on_target) { // doesn't vary on target or neighbor
+                    pre_T = prestencil_weights(0, 0, 0, pre_transform_local_index, 
+                            pre_transform_global_index); 
+                }
+            }
+
+            double staggered_value_from_targets = 0;
+            double pre_T_staggered = 1.0;
+            auto alpha_index2 = gmls.getAlphaIndexDevice(target_index, alpha_input_output_component_index2);
+            const double alpha_scale2 = gmls.getAlphaScaleDevice(target_index, alpha_input_output_component_index2);
+            // loops over target_index for each neighbor for staggered approaches
+            if (target_plus_neighbor_staggered_schema) {
+                Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, nla.getNumberOfNeighborsDevice(target_index)), [=](const int i, double& t_value) {
+                    const double neighbor_varying_pre_T_staggered =  (weight_with_pre_T && vary_on_neighbor) ?
+                        prestencil_weights(1, target_index, i, pre_transform_local_index, pre_transform_global_index)
+                        : 1.0;
+
+                    t_value += neighbor_varying_pre_T_staggered * sampling_data_single_column(nla.getNeighborDevice(target_index, 0))
+                                *stored_alphas(alpha_index2 + i);
+
+                }, staggered_value_from_targets );
+                staggered_value_from_targets *= alpha_scale2;
+
+                // for staggered approaches that transform source data for the target and neighbors
+                if (weight_with_pre_T) {
+                    if (!vary_on_neighbor && vary_on_target) {
+                        pre_T_staggered = prestencil_weights(1, target_index, 0, pre_transform_local_index, 
+                                pre_transform_global_index); 
+                    } else if (!vary_on_target) { // doesn't vary on target or neighbor
+                        pre_T_staggered = prestencil_weights(1, 0, 0, pre_transform_local_index, 
+                                pre_transform_global_index); 
+                    }
+                }
+            }
+
+            double added_value = pre_T*gmls_value + pre_T_staggered*staggered_value_from_targets;
+            Kokkos::single(Kokkos::PerTeam(teamMember), [=] () {
+                output_data_single_column(target_index) = previous_value + added_value;
+            });
+        });
+        Kokkos::fence();
+    }
+
 }; // Evaluator
 
 } // Compadre
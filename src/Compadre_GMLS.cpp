@@ -8,10 +8,69 @@
 
 #include "KokkosBatched_Gemm_Decl.hpp"
 
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <unistd.h>
+
 namespace Compadre {
 
 void GMLS::generatePolynomialCoefficients(const int number_of_batches, const bool keep_coefficients) {
 
+    this->generateCoefficientsForTargetsByOrder(number_of_batches, keep_coefficients, std::vector<int>(), false /* regenerating */);
+    this->finalizeAlphas();
+
+}
+
+void GMLS::generateCoefficientsForTargetsByOrder(const int number_of_batches, const bool keep_coefficients, 
+        const std::vector<int>& target_subset, const bool regenerating) {
+
+    if (_host_poly_orders.extent(0) == 0) {
+        this->generateCoefficientsForTargets(number_of_batches, keep_coefficients, target_subset, regenerating);
+        return;
+    }
+
+    const int number_of_targets = _target_coordinates.extent(0);
+    compadre_assert_release(((int)_host_poly_orders.extent(0) == number_of_targets)
+            && "setPolynomialOrders must be given an order for each target site.");
+    compadre_assert_release((_problem_type == ProblemType::STANDARD)
+            && "Polynomial orders set for each target site are only supported for STANDARD problems.");
+    compadre_assert_release((!keep_coefficients)
+            && "keep_coefficients must be false when polynomial orders are set for each target site.");
+    compadre_assert_release((_polynomial_sampling_functional != StaggeredEdgeAnalyticGradientIntegralSample)
+            && "Polynomial orders set for each target site are not supported for StaggeredEdgeAnalyticGradientIntegralSample.");
+
+    // target sites (all of them, or those in target_subset) grouped by polynomial order, in increasing order
+    std::map<int, std::vector<int> > targets_of_order;
+    if (target_subset.size() > 0) {
+        for (auto target_index : target_subset) targets_of_order[_host_poly_orders(target_index)].push_back(target_index);
+    } else {
+        for (int i=0; i<number_of_targets; ++i) targets_of_order[_host_poly_orders(i)].push_back(i);
+    }
+
+    // each group is solved with its own basis size and scratch sizes, and writes its alphas into the same
+    // _alphas, which is only allocated by the first group unless regenerating
+    const int poly_order = _poly_order;
+    bool alphas_allocated = regenerating;
+    for (auto& group : targets_of_order) {
+        compadre_assert_release((group.first >= 0) && "Polynomial orders must be non-negative.");
+        _poly_order = group.first;
+        _NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
+        this->generateCoefficientsForTargets(number_of_batches, false /* keep_coefficients */, group.second, alphas_allocated);
+        alphas_allocated = true;
+    }
+    _poly_order = poly_order;
+    _NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
+
+}
+
+void GMLS::generateCoefficientsForTargets(const int number_of_batches, const bool keep_coefficients, 
+        const std::vector<int>& target_subset, const bool regenerating) {
+
+    // only target sites in target_subset are solved for (all of them if empty), and when regenerating, _alphas 
+    // (already laid out for the current neighbor lists) is written into rather than reallocated
+
     compadre_assert_release( (keep_coefficients==false || number_of_batches==1)
                 && "keep_coefficients is set to true, but number of batches exceeds 1.");
 
@@ -62,37 +121,66 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     const int added_coeff_size = getAdditionalCoeffSizeFromConstraintAndSpace(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions);
 
     // initialize all alpha values to be used for taking the dot product with data to get a reconstruction 
-    try {
-        global_index_type total_neighbors = _neighbor_lists.getTotalNeighborsOverAllListsHost();
-        int total_added_alphas = _target_coordinates.extent(0)*_added_alpha_size;
-        _alphas = decltype(_alphas)("alphas", (total_neighbors + TO_GLOBAL(total_added_alphas))
-                    *TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target));
-        // this deep copy writes to all theoretically allocated memory,
-        // ensuring that allocation attempted was successful
-        compadre_assert_debug((deep_copy(_alphas, 0.0), true));
-    } catch(std::exception &e) {
-       printf("Insufficient memory to store alphas: \n\n%s", e.what()); 
-       throw e;
+    if (!regenerating) {
+        // release previously generated alphas before allocating new ones
+        _alphas = decltype(_alphas)();
+        _float_alphas = decltype(_float_alphas)();
+        _int16_alphas = decltype(_int16_alphas)();
+        _alpha_scales = decltype(_alpha_scales)();
+        _host_alpha_scales = decltype(_host_alpha_scales)();
+        _stored_alpha_type = AlphaStorageType::DoubleAlphas;
+        try {
+            global_index_type total_neighbors = _neighbor_lists.getTotalNeighborsOverAllListsHost();
+            int total_added_alphas = _target_coordinates.extent(0)*_added_alpha_size;
+            _alphas = decltype(_alphas)("alphas", (total_neighbors + TO_GLOBAL(total_added_alphas))
+                        *TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target));
+            // this deep copy writes to all theoretically allocated memory,
+            // ensuring that allocation attempted was successful
+            compadre_assert_debug((deep_copy(_alphas, 0.0), true));
+        } catch(std::exception &e) {
+           printf("Insufficient memory to store alphas: \n\n%s", e.what()); 
+           throw e;
+        }
     }
 
     // initialize the prestencil weights that are applied to sampling data to put it into a form 
     // that the GMLS operator will be able to operate on
     auto sro = _data_sampling_functional;
-    try {
-        _prestencil_weights = decltype(_prestencil_weights)("Prestencil weights",
-                std::pow(2,sro.use_target_site_weights), 
-                (sro.transform_type==DifferentEachTarget 
-                        || sro.transform_type==DifferentEachNeighbor) ?
-                    _neighbor_lists.getNumberOfTargets() : 1,
-                (sro.transform_type==DifferentEachNeighbor) ?
-                    _max_num_neighbors : 1,
-                (sro.output_rank>0) ?
-                    _local_dimensions : 1,
-                (sro.input_rank>0) ?
-                    _global_dimensions : 1);
-    } catch(std::exception &e) {
-       printf("Insufficient memory to store prestencil weights: \n\n%s", e.what()); 
-       throw e;
+    const size_t prestencil_extents[5] = {
+        (size_t)std::pow(2,sro.use_target_site_weights),
+        (sro.transform_type==DifferentEachTarget 
+                || sro.transform_type==DifferentEachNeighbor) ?
+            (size_t)_neighbor_lists.getNumberOfTargets() : 1,
+        (sro.transform_type==DifferentEachNeighbor) ?
+            (size_t)_max_num_neighbors : 1,
+        (sro.output_rank>0) ?
+            (size_t)_local_dimensions : 1,
+        (sro.input_rank>0) ?
+            (size_t)_global_dimensions : 1};
+    bool reuse_prestencil_weights = regenerating;
+    for (int dim=0; dim<5; ++dim) {
+        reuse_prestencil_weights &= (_prestencil_weights.extent(dim)==prestencil_extents[dim]);
+    }
+    // when regenerating with unchanged extents, weights of target sites that are not regenerated
+    // are already in place and the existing view is kept
+    if (!reuse_prestencil_weights) {
+        auto previous_prestencil_weights = _prestencil_weights;
+        try {
+            _prestencil_weights = decltype(_prestencil_weights)("Prestencil weights",
+                    prestencil_extents[0], prestencil_extents[1], prestencil_extents[2],
+                    prestencil_extents[3], prestencil_extents[4]);
+        } catch(std::exception &e) {
+           printf("Insufficient memory to store prestencil weights: \n\n%s", e.what()); 
+           throw e;
+        }
+        if (regenerating) {
+            // keep prestencil weights of target sites that are not regenerated
+            auto overlap = [&](const int dim) { 
+                return std::make_pair(0, (int)std::min(_prestencil_weights.extent(dim), previous_prestencil_weights.extent(dim))); 
+            };
+            Kokkos::deep_copy(Kokkos::subview(_prestencil_weights, overlap(0), overlap(1), overlap(2), overlap(3), overlap(4)),
+                    Kokkos::subview(previous_prestencil_weights, overlap(0), overlap(1), overlap(2), overlap(3), overlap(4)));
+        }
     }
     Kokkos::fence();
 
@@ -119,7 +207,8 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     _data_sampling_multiplier = getOutputDimensionOfSampling(_data_sampling_functional);
 
     // special case for using a higher order for sampling from a polynomial space that are gradients of a scalar polynomial
-    if (_polynomial_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample) {
+    // (already done when the coefficients were first generated if regenerating)
+    if (_polynomial_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample && !regenerating) {
         // if the reconstruction is being made with a gradient of a basis, then we want that basis to be one order higher so that
         // the gradient is consistent with the convergence order expected.
         _poly_order += 1;
@@ -131,67 +220,38 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
      */
 
     // for tallying scratch space needed for device kernel calls
-    int team_scratch_size_a = 0;
-
-    // TEMPORARY, take to zero after conversion
-    int team_scratch_size_b = 0;
-    int thread_scratch_size_a = 0;
-    int thread_scratch_size_b = 0;
+    int team_scratch_size_a, team_scratch_size_b, thread_scratch_size_a, thread_scratch_size_b;
 
     // dimensions that are relevant for each subproblem
     int max_num_rows = _sampling_multiplier*_max_num_neighbors;
-    int this_num_cols = _basis_multiplier*_NP;
-    int manifold_NP = 0;
+    int this_num_cols, manifold_NP;
+    this->getProblemSizes(_poly_order, _basis_multiplier, _sampling_multiplier, _max_num_neighbors, this_num_cols, manifold_NP,
+            team_scratch_size_a, team_scratch_size_b, thread_scratch_size_a, thread_scratch_size_b);
 
     if (_problem_type == ProblemType::MANIFOLD) {
         // these dimensions already calculated differ in the case of manifolds
-        manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
         _NP = this->getNP(_poly_order, _dimensions-1, _reconstruction_space);
-        const int max_manifold_NP = (manifold_NP > _NP) ? manifold_NP : _NP;
-        this_num_cols = _basis_multiplier*max_manifold_NP;
-        const int max_poly_order = (_poly_order > _curvature_poly_order) ? _poly_order : _curvature_poly_order;
-        const int max_P_row_size = ((_dimensions-1)*manifold_NP > max_manifold_NP*_total_alpha_values*_basis_multiplier) ? (_dimensions-1)*manifold_NP : max_manifold_NP*_total_alpha_values*_basis_multiplier*_max_evaluation_sites_per_target;
-
-        /*
-         *    Calculate Scratch Space Allocations
-         */
-
-        team_scratch_size_b += scratch_matrix_right_type::shmem_size(_dimensions-1, _dimensions-1); // G
-        team_scratch_size_b += scratch_matrix_right_type::shmem_size(_dimensions, _dimensions); // PTP matrix
-        team_scratch_size_b += scratch_vector_type::shmem_size( (_dimensions-1)*_max_num_neighbors ); // manifold_gradient
-
-        team_scratch_size_b += scratch_vector_type::shmem_size(_max_num_neighbors*std::max(_sampling_multiplier,_basis_multiplier)); // t1 work vector for qr
-        team_scratch_size_b += scratch_vector_type::shmem_size(_max_num_neighbors*std::max(_sampling_multiplier,_basis_multiplier)); // t2 work vector for qr
-
-        team_scratch_size_b += scratch_vector_type::shmem_size(max_P_row_size); // row of P matrix, one for each operator
-        thread_scratch_size_b += scratch_vector_type::shmem_size(max_manifold_NP*_basis_multiplier); // delta, used for each thread
-        thread_scratch_size_b += scratch_vector_type::shmem_size((max_poly_order+1)*_global_dimensions); // temporary space for powers in basis
-        if (_data_sampling_functional == VaryingManifoldVectorPointSample) {
-            thread_scratch_size_b += scratch_vector_type::shmem_size(_dimensions*_dimensions); // temporary tangent calculations, used for each thread
-        }
 
+    }
+    // small standard problems are assembled, solved, and have targets applied in a single kernel
+    // that never writes P*sqrt(w), its factorization, or the coefficients to global memory
+    const bool fuse_standard_solve = this->canFuseStandardSolve(keep_coefficients, max_num_rows, this_num_cols, team_scratch_size_a);
+    if (fuse_standard_solve) {
+        int fused_team_scratch_size_a, fused_team_scratch_size_b;
+        this->getFusedStandardSolveScratchSizes(max_num_rows, this_num_cols, fused_team_scratch_size_a, fused_team_scratch_size_b);
+        team_scratch_size_a += fused_team_scratch_size_a;
+        team_scratch_size_b += fused_team_scratch_size_b;
+    }
+    // standard problems with few target functionals solve for them, rather than for the coefficients
+    const bool solve_targets_first = this->solvesTargetsFirst(keep_coefficients, max_num_rows);
+    const int num_target_rows = _total_alpha_values*_max_evaluation_sites_per_target;
 
+    if (_problem_type == ProblemType::MANIFOLD && !regenerating) {
         // allocate data on the device (initialized to zero)
         _T = Kokkos::View<double*>("tangent approximation",_target_coordinates.extent(0)*_dimensions*_dimensions);
         _manifold_metric_tensor_inverse = Kokkos::View<double*>("manifold metric tensor inverse",_target_coordinates.extent(0)*(_dimensions-1)*(_dimensions-1));
         _manifold_curvature_coefficients = Kokkos::View<double*>("manifold curvature coefficients",_target_coordinates.extent(0)*manifold_NP);
         _manifold_curvature_gradient = Kokkos::View<double*>("manifold curvature gradient",_target_coordinates.extent(0)*(_dimensions-1));
-
-    } else  { // Standard GMLS
-
-        /*
-         *    Calculate Scratch Space Allocations
-         */
-
-        team_scratch_size_a += scratch_vector_type::shmem_size(max_num_rows); // t1 work vector for qr
-        team_scratch_size_a += scratch_vector_type::shmem_size(max_num_rows); // t2 work vector for qr
-
-        // row of P matrix, one for each operator
-        // +1 is for the original target site which always gets evaluated
-        team_scratch_size_b += scratch_vector_type::shmem_size(this_num_cols*_total_alpha_values*_max_evaluation_sites_per_target); 
-
-        thread_scratch_size_b += scratch_vector_type::shmem_size(this_num_cols); // delta, used for each thread
-        thread_scratch_size_b += scratch_vector_type::shmem_size((_poly_order+1)*_global_dimensions); // temporary space for powers in basis
     }
     _pm.setTeamScratchSize(0, team_scratch_size_a);
     _pm.setTeamScratchSize(1, team_scratch_size_b);
@@ -208,20 +268,107 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     int P_dim_0, P_dim_1;
     getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
 
+    /*
+     *    Find Target Sites With Equivalent Neighborhoods
+     */
+
+    // target sites whose neighborhoods are translations and scalings of another target site's neighborhood
+    // are not solved for, and instead have alphas copied from that target site after all batches are solved
+    Kokkos::View<int*> stencil_representatives, stencil_neighbor_permutation;
+    std::vector<int> solved_targets;
+    if (!regenerating) {
+        _number_of_deduplicated_targets = 0;
+        if (target_subset.size() == 0 && this->canDeduplicateStencils(keep_coefficients)) {
+            solved_targets = this->findStencilRepresentatives(stencil_representatives, stencil_neighbor_permutation);
+        }
+    }
+    const std::vector<int>& batched_targets = (target_subset.size() > 0) ? target_subset : solved_targets;
+
+    /*
+     *    Determine Batches
+     */
+
+    // each batch is a contiguous range of target sites (in processing order), along with the largest
+    // number of neighbors for any target site in that range, which determines the size of its tiles
+    std::vector<global_index_type> batch_starts, batch_sizes;
+    std::vector<int> batch_max_num_neighbors, host_ordering;
+
+    const int max_num_neighbors_over_all_targets = _max_num_neighbors;
+
+    compadre_assert_release( (keep_coefficients==false || _number_of_neighbor_buckets==1)
+                && "keep_coefficients is set to true, but number of neighbor buckets exceeds 1.");
+
+    this->determineBatches(number_of_batches, _number_of_neighbor_buckets, batched_targets, host_ordering, 
+            batch_starts, batch_sizes, batch_max_num_neighbors);
+
+    // processing order of target sites (empty if processed in their original order)
+    _target_ordering = decltype(_target_ordering)("target ordering", host_ordering.size());
+    auto host_target_ordering = Kokkos::create_mirror_view(_target_ordering);
+    for (size_t i=0; i<host_ordering.size(); ++i) host_target_ordering(i) = host_ordering[i];
+    Kokkos::deep_copy(_target_ordering, host_target_ordering);
+
     /*
      *    Allocate Global Device Storage of Data Needed Over Multiple Calls
      */
 
-    global_index_type max_batch_size = (_target_coordinates.extent(0) + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
+    // storage is sized by the batch requiring the most memory
+    global_index_type RHS_size, P_size, w_size;
+    this->getBatchStorageSizes(_sampling_multiplier, this_num_cols, batch_sizes, batch_max_num_neighbors, RHS_size, P_size, w_size);
+    if (fuse_standard_solve) RHS_size = P_size = w_size = 0;
+    const global_index_type projected_targets_size = (solve_targets_first) ? 
+        this->getProjectedTargetsStorageSize(this_num_cols, batch_sizes) : 0;
+    // batchCholeskySolve flags which matrices need a fallback solve in this storage, rather than allocating
+    // (and synchronizing on freeing) its own for each batch
+    const global_index_type solve_flags_size = (_dense_solver_type == DenseSolverType::Cholesky && !fuse_standard_solve) ?
+        2*(*std::max_element(batch_sizes.begin(), batch_sizes.end())) : 0;
+
+    Kokkos::View<int*> solve_flags;
     try {
-        _RHS = Kokkos::View<double*>("RHS", max_batch_size*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1));
-        _P = Kokkos::View<double*>("P", max_batch_size*TO_GLOBAL(P_dim_0)*TO_GLOBAL(P_dim_1));
-        _w = Kokkos::View<double*>("w", max_batch_size*TO_GLOBAL(max_num_rows));
+        _RHS = Kokkos::View<double*>("RHS", RHS_size);
+        _P = Kokkos::View<double*>("P", P_size);
+        _w = Kokkos::View<double*>("w", w_size);
+        _projected_targets = Kokkos::View<double*>("projected targets", projected_targets_size);
+        solve_flags = Kokkos::View<int*>("solve flags", solve_flags_size);
     } catch (std::exception &e) {
         printf("Failed to allocate space for RHS, P, and w. Consider increasing number_of_batches: \n\n%s", e.what());
         throw e;
     }
     Kokkos::fence();
+
+    // when pipelining, consecutive batches alternate between two sets of _P, _RHS, and _w, and each
+    // set is only ever used by kernels launched on its own execution space instance, so a batch can be
+    // assembled while the previous batch is still being solved without any synchronization between them
+    // (only worthwhile when distinct instances execute concurrently)
+    const bool pipeline_batches = _pipeline_batches && ParallelManager::hasIndependentExecutionSpaces()
+        && (_problem_type != ProblemType::MANIFOLD) && !fuse_standard_solve && (batch_sizes.size() > 1);
+    const int number_of_buffers = (pipeline_batches) ? 2 : 1;
+    std::vector<Kokkos::View<double*> > RHS_buffers(1, _RHS), P_buffers(1, _P), w_buffers(1, _w), 
+        projected_targets_buffers(1, _projected_targets);
+    std::vector<Kokkos::View<int*> > solve_flags_buffers(1, solve_flags);
+    std::vector<device_execution_space> batch_spaces(1, _pm.getExecutionSpace());
+#ifdef COMPADRE_USE_CUDA
+    std::vector<cudaStream_t> batch_streams(number_of_buffers);
+#endif
+    if (pipeline_batches) {
+        try {
+            RHS_buffers.push_back(Kokkos::View<double*>("RHS", RHS_size));
+            P_buffers.push_back(Kokkos::View<double*>("P", P_size));
+            w_buffers.push_back(Kokkos::View<double*>("w", w_size));
+            projected_targets_buffers.push_back(Kokkos::View<double*>("projected targets", projected_targets_size));
+            solve_flags_buffers.push_back(Kokkos::View<int*>("solve flags", solve_flags_size));
+        } catch (std::exception &e) {
+            printf("Failed to allocate a second set of RHS, P, and w for pipelined batches. Consider disabling pipelining: \n\n%s", e.what());
+            throw e;
+        }
+        batch_spaces.resize(number_of_buffers);
+#ifdef COMPADRE_USE_CUDA
+        for (int i=0; i<number_of_buffers; ++i) {
+            cudaStreamCreate(&batch_streams[i]);
+            batch_spaces[i] = Kokkos::Cuda(batch_streams[i]);
+        }
+#endif
+        Kokkos::fence();
+    }
     
     /*
      *    Calculate Optimal Threads Based On Levels of Parallelism
@@ -233,20 +380,42 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     }
 
 
-    _initial_index_for_batch = 0;
-    for (int batch_num=0; batch_num<number_of_batches; ++batch_num) {
+    // pipelined batches skip the fences batched solvers make after their kernels, so that the next batch
+    // is launched on the other instance before this batch's solve completes (no stage of a STANDARD problem fences)
+    _pm.setFenceBatchedSolves(!pipeline_batches);
+    for (size_t batch_num=0; batch_num<batch_sizes.size(); ++batch_num) {
+
+        _initial_index_for_batch = batch_starts[batch_num];
+        auto this_batch_size = batch_sizes[batch_num];
+
+        if (pipeline_batches) {
+            // kernels on one instance execute in order, so this set of buffers is not overwritten
+            // until the batch that last used it has been applied
+            const int buffer_num = batch_num % number_of_buffers;
+            _RHS = RHS_buffers[buffer_num];
+            _P = P_buffers[buffer_num];
+            _w = w_buffers[buffer_num];
+            _projected_targets = projected_targets_buffers[buffer_num];
+            solve_flags = solve_flags_buffers[buffer_num];
+            _pm.setExecutionSpace(batch_spaces[buffer_num]);
+        }
+
+        // tiles in _P, _RHS, and _w are sized by the largest neighborhood in this batch
+        _max_num_neighbors = batch_max_num_neighbors[batch_num];
+        max_num_rows = _sampling_multiplier*_max_num_neighbors;
+        getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, RHS_dim_0, RHS_dim_1);
+        getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
 
-        auto this_batch_size = std::min(_target_coordinates.extent(0)-_initial_index_for_batch, max_batch_size);
-        Kokkos::deep_copy(_RHS, 0.0);
-        Kokkos::deep_copy(_P, 0.0);
-        Kokkos::deep_copy(_w, 0.0);
-        
         if (_problem_type == ProblemType::MANIFOLD) {
 
             /*
              *    MANIFOLD Problems
              */
 
+            Kokkos::deep_copy(_RHS, 0.0);
+            Kokkos::deep_copy(_P, 0.0);
+            Kokkos::deep_copy(_w, 0.0);
+
             if (!_orthonormal_tangent_space_provided) { // user did not specify orthonormal tangent directions, so we approximate them first
                 // coarse tangent plane approximation construction of P^T*P
                 _pm.CallFunctorWithTeamThreads<ComputeCoarseTangentPlane>(*this, this_batch_size);
@@ -262,13 +431,13 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
                 // assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity for curvature
                 _pm.CallFunctorWithTeamThreads<AssembleCurvaturePsqrtW>(*this, this_batch_size);
 
-                if (_dense_solver_type == DenseSolverType::LU) {
-                    // solves P^T*P against P^T*W with LU, stored in P
-                    Kokkos::Profiling::pushRegion("Curvature LU Factorization");
-                    // batchLU expects layout_left matrix tiles for B
+                if (_dense_solver_type == DenseSolverType::Cholesky) {
+                    // solves P^T*P against P^T*W with Cholesky, stored in P
+                    Kokkos::Profiling::pushRegion("Curvature Cholesky Factorization");
+                    // batchCholeskySolve expects layout_left matrix tiles for B
                     // by giving it layout_right matrix tiles with reverse ordered ldb and ndb
                     // it effects a transpose of _P in layout_left
-                    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, manifold_NP, manifold_NP, _max_num_neighbors, this_batch_size);
+                    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, manifold_NP, _max_num_neighbors, this_batch_size, _precision_policy == PrecisionPolicy::MixedPrecision, solve_flags.data());
                     Kokkos::Profiling::popRegion();
                 } else {
                     // solves P*sqrt(weights) against sqrt(weights)*Identity with QR, stored in RHS
@@ -283,7 +452,7 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
                 // Due to converting layout, entries that are assumed zeros may become non-zeros.
                 Kokkos::deep_copy(_P, 0.0);
 
-                if (batch_num==number_of_batches-1) {
+                if (batch_num==batch_sizes.size()-1) {
                     // copy tangent bundle from device back to host
                     _host_T = Kokkos::create_mirror_view(_T);
                     Kokkos::deep_copy(_host_T, _T);
@@ -294,10 +463,10 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             // assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity for curvature
             _pm.CallFunctorWithTeamThreads<AssembleCurvaturePsqrtW>(*this, this_batch_size);
 
-            if (_dense_solver_type == DenseSolverType::LU) {
-                // solves P^T*P against P^T*W with LU, stored in P
-                Kokkos::Profiling::pushRegion("Curvature LU Factorization");
-                GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, manifold_NP, manifold_NP, _max_num_neighbors, this_batch_size);
+            if (_dense_solver_type == DenseSolverType::Cholesky) {
+                // solves P^T*P against P^T*W with Cholesky, stored in P
+                Kokkos::Profiling::pushRegion("Curvature Cholesky Factorization");
+                GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, manifold_NP, _max_num_neighbors, this_batch_size, _precision_policy == PrecisionPolicy::MixedPrecision, solve_flags.data());
                 Kokkos::Profiling::popRegion();
             } else {
                  // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
@@ -323,9 +492,9 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             _pm.CallFunctorWithTeamThreads<AssembleManifoldPsqrtW>(*this, this_batch_size);
 
             // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
-            if (_dense_solver_type == DenseSolverType::LU) {
-                Kokkos::Profiling::pushRegion("Manifold LU Factorization");
-                GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols, this_num_cols, max_num_rows, this_batch_size);
+            if (_dense_solver_type == DenseSolverType::Cholesky) {
+                Kokkos::Profiling::pushRegion("Manifold Cholesky Factorization");
+                GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols, max_num_rows, this_batch_size, _precision_policy == PrecisionPolicy::MixedPrecision, solve_flags.data());
                 Kokkos::Profiling::popRegion();
             } else {
                 Kokkos::Profiling::pushRegion("Manifold QR+Pivoting Factorization");
@@ -334,6 +503,18 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             }
             Kokkos::fence();
 
+        } else if (fuse_standard_solve) {
+
+            /*
+             *    STANDARD GMLS Problems (in a single kernel)
+             */
+
+            // assembles the P*sqrt(weights) matrix, solves it against sqrt(weights)*Identity, and evaluates
+            // targets, applying them to the polynomial coefficients to store in _alphas
+            this->launchAssembleSolveApplyStandard(this_batch_size);
+
+            _pm.CallFunctorWithTeamThreadsAndVectors<ComputePrestencilWeights>(*this, this_batch_size);
+
         } else {
 
             /*
@@ -341,15 +522,31 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
              */
 
             // assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity
-            _pm.CallFunctorWithTeamThreads<AssembleStandardPsqrtW>(*this, this_batch_size);
-            //_pm.CallFunctorWithTeamThreads<AssembleStandardPsqrtW>(this_batch_size, *this);
-            Kokkos::fence();
+            // (each target's tiles of _P, _RHS, and _w are zeroed by this functor)
+            this->launchAssembleStandardPsqrtW(this_batch_size);
 
             // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
-            if (_dense_solver_type == DenseSolverType::LU) {
+            if (_dense_solver_type == DenseSolverType::Cholesky) {
+                if (_constraint_type == ConstraintType::NO_CONSTRAINT && solve_targets_first) {
+                    // evaluates targets, stored in _projected_targets
+                    _pm.CallFunctorWithTeamThreadsAndVectors<EvaluateStandardTargets>(*this, this_batch_size);
+
+                    // P^T*W*P is symmetric positive definite, solved against P_target_row^T rather than P^T*W
+                    // (each tile of P_target_row is read as a layout_left P_target_row^T)
+                    Kokkos::Profiling::pushRegion("Cholesky Factorization");
+                    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_left>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _projected_targets.data(), this_num_cols, num_target_rows, this_num_cols, num_target_rows, this_batch_size, _precision_policy == PrecisionPolicy::MixedPrecision, solve_flags.data());
+                    Kokkos::Profiling::popRegion();
+                } else if (_constraint_type == ConstraintType::NO_CONSTRAINT) {
+                    // P^T*W*P is symmetric positive definite
+                    Kokkos::Profiling::pushRegion("Cholesky Factorization");
+                    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols, max_num_rows, this_batch_size, _precision_policy == PrecisionPolicy::MixedPrecision, solve_flags.data());
+                    Kokkos::Profiling::popRegion();
+                } else {
+                    // constraints make the system indefinite
                     Kokkos::Profiling::pushRegion("LU Factorization");
                     GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + _added_alpha_size, this_batch_size);
                     Kokkos::Profiling::popRegion();
+                }
             } else {
                 Kokkos::Profiling::pushRegion("QR+Pivoting Factorization");
                 if (_constraint_type != ConstraintType::NO_CONSTRAINT) {
@@ -361,7 +558,6 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             }
 
             _pm.CallFunctorWithTeamThreadsAndVectors<ComputePrestencilWeights>(*this, this_batch_size);
-            Kokkos::fence();
         }
 
         /*
@@ -378,7 +574,16 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             // evaluates targets, applies target evaluation to polynomial coefficients to store in _alphas
             _pm.CallFunctorWithTeamThreads<ApplyManifoldTargets>(*this, this_batch_size);
 
-        } else {
+        } else if (solve_targets_first) {
+
+            /*
+             *    STANDARD GMLS Problems (targets solved for first)
+             */
+
+            // applies targets already multiplied by (P^T*W*P)^-1 to P^T*W to store in _alphas
+            _pm.CallFunctorWithTeamThreadsAndVectors<ApplyProjectedStandardTargets>(*this, this_batch_size);
+
+        } else if (!fuse_standard_solve) {
 
             /*
              *    STANDARD GMLS Problems
@@ -388,23 +593,37 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             _pm.CallFunctorWithTeamThreadsAndVectors<ApplyStandardTargets>(*this, this_batch_size);
 
         }
-        Kokkos::fence();
-        _initial_index_for_batch += this_batch_size;
-        if ((size_t)_initial_index_for_batch == _target_coordinates.extent(0)) break;
     } // end of batch loops
+    Kokkos::fence();
+    _pm.setFenceBatchedSolves(true);
+    if (pipeline_batches) {
+        _pm.setExecutionSpace(device_execution_space());
+        batch_spaces.clear();
+#ifdef COMPADRE_USE_CUDA
+        for (int i=0; i<number_of_buffers; ++i) cudaStreamDestroy(batch_streams[i]);
+#endif
+    }
+    _initial_index_for_batch = 0;
+    _max_num_neighbors = max_num_neighbors_over_all_targets;
+
+    if (!regenerating && _number_of_deduplicated_targets > 0) {
+        this->copyAlphasFromRepresentatives(stencil_representatives, stencil_neighbor_permutation);
+    }
 
     // deallocate _P and _w
     _w = Kokkos::View<double*>("w",0);
-    if (number_of_batches > 1) { // no reason to keep coefficients if they aren't all in memory
+    _projected_targets = Kokkos::View<double*>("projected targets",0);
+    if (number_of_batches > 1 || _number_of_neighbor_buckets > 1 || target_subset.size() > 0) { // no reason to keep coefficients if they aren't all in memory
         _RHS = Kokkos::View<double*>("RHS",0);
         _P = Kokkos::View<double*>("P",0);
         _entire_batch_computed_at_once = false;
+        _store_PTWP_inv_PTW = false;
     } else {
         if (_constraint_type != ConstraintType::NO_CONSTRAINT) {
             _RHS = Kokkos::View<double*>("RHS", 0);
             if (!keep_coefficients) _P = Kokkos::View<double*>("P", 0);
         } else {
-            if (_dense_solver_type != DenseSolverType::LU) {
+            if (_dense_solver_type != DenseSolverType::Cholesky) {
                 _P = Kokkos::View<double*>("P", 0);
                 if (!keep_coefficients) _RHS = Kokkos::View<double*>("RHS", 0);
             } else {
@@ -415,19 +634,33 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
         if (keep_coefficients) _store_PTWP_inv_PTW = true;
     }
 
+}
+
+void GMLS::finalizeAlphas() {
+
     /*
      *    Device to Host Copy Of Solution
      */
 
-    // copy computed alphas back to the host
-    _host_alphas = Kokkos::create_mirror_view(_alphas);
     if (_data_sampling_functional != PointSample) {
         _host_prestencil_weights = Kokkos::create_mirror_view(_prestencil_weights);
         Kokkos::deep_copy(_host_prestencil_weights, _prestencil_weights);
     }
-    Kokkos::deep_copy(_host_alphas, _alphas);
-    Kokkos::fence();
 
+    // layout of _alphas, needed if a subset of target sites is regenerated later
+    _alphas_neighbor_lists = _neighbor_lists;
+
+    // alphas are generated in double precision, then compressed if requested
+    if (_alpha_storage_type != AlphaStorageType::DoubleAlphas) this->compressAlphas();
+
+    // copy computed alphas back to the host, unless deferred until first needed on the host
+    _host_alphas_synced = false;
+    if (!_lazy_host_alphas) {
+        this->syncAlphasToHost();
+    } else {
+        // release any host copy of previously generated alphas
+        _host_alphas = decltype(_host_alphas)();
+    }
 
 }
 
@@ -437,19 +670,816 @@ void GMLS::generateAlphas(const int number_of_batches, const bool keep_coefficie
 
 }
 
+void GMLS::generateAlphas(const GMLSMemoryPlan& plan) {
+
+    this->setNumberOfNeighborBuckets(plan.number_of_neighbor_buckets);
+    this->generatePolynomialCoefficients(plan.number_of_batches, false /* keep_coefficients */);
+
+}
+
+void GMLS::regenerateAlphas(const std::vector<int>& dirty_target_indices, const int number_of_batches) {
+
+    const int number_of_targets = _target_coordinates.extent(0);
+    compadre_assert_release((_alphas_neighbor_lists.getNumberOfTargets() == number_of_targets)
+            && "generateAlphas must be called with the same target sites before regenerateAlphas.");
+    compadre_assert_release(((size_t)_neighbor_lists.getNumberOfTargets()==_target_coordinates.extent(0)) 
+            && "Neighbor lists must have a row for each target site when calling regenerateAlphas.");
+
+    // sorted and without duplicates
+    std::vector<int> dirty_targets(dirty_target_indices);
+    std::sort(dirty_targets.begin(), dirty_targets.end());
+    dirty_targets.erase(std::unique(dirty_targets.begin(), dirty_targets.end()), dirty_targets.end());
+    if (dirty_targets.size() == 0) return;
+    compadre_assert_release((dirty_targets.front() >= 0 && dirty_targets.back() < number_of_targets)
+            && "dirty_target_indices contains an index that is not a target site.");
+
+    // only target sites being regenerated may have changed their number of neighbors
+    std::vector<int> host_is_dirty(number_of_targets, 0);
+    for (auto target_index : dirty_targets) host_is_dirty[target_index] = 1;
+    bool layout_changed = false;
+    for (int i=0; i<number_of_targets; ++i) {
+        if (_alphas_neighbor_lists.getNumberOfNeighborsHost(i) != _neighbor_lists.getNumberOfNeighborsHost(i)) {
+            compadre_assert_release(host_is_dirty[i] 
+                    && "A target site whose number of neighbors changed is not in dirty_target_indices.");
+            layout_changed = true;
+        }
+    }
+
+    // regenerated alphas are written into double precision alphas, compressed again afterward
+    if (_stored_alpha_type != AlphaStorageType::DoubleAlphas) {
+        _alphas = this->decodeAlphas();
+        _float_alphas = decltype(_float_alphas)();
+        _int16_alphas = decltype(_int16_alphas)();
+        _alpha_scales = decltype(_alpha_scales)();
+        _host_alpha_scales = decltype(_host_alpha_scales)();
+        _stored_alpha_type = AlphaStorageType::DoubleAlphas;
+    }
+
+    const global_index_type alphas_per_neighbor = TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target);
+    compadre_assert_release((_alphas.extent(0) == (_alphas_neighbor_lists.getTotalNeighborsOverAllListsHost() 
+                    + TO_GLOBAL(number_of_targets*_added_alpha_size))*alphas_per_neighbor)
+            && "Target operations changed since alphas were generated, so all alphas must be generated again.");
+
+    if (layout_changed) {
+
+        // each target site's alphas are contiguous, beginning at its row offset in the neighbor lists, so blocks
+        // of target sites not being regenerated are moved to their offsets in the new neighbor lists
+        Kokkos::View<int*> is_dirty("target sites being regenerated", number_of_targets);
+        auto host_is_dirty_view = Kokkos::create_mirror_view(is_dirty);
+        for (int i=0; i<number_of_targets; ++i) host_is_dirty_view(i) = host_is_dirty[i];
+        Kokkos::deep_copy(is_dirty, host_is_dirty_view);
+
+        decltype(_alphas) repacked_alphas;
+        try {
+            repacked_alphas = decltype(_alphas)("alphas", (_neighbor_lists.getTotalNeighborsOverAllListsHost() 
+                        + TO_GLOBAL(number_of_targets*_added_alpha_size))*alphas_per_neighbor);
+        } catch(std::exception &e) {
+           printf("Insufficient memory to store alphas: \n\n%s", e.what()); 
+           throw e;
+        }
+
+        auto alphas = _alphas;
+        auto old_neighbor_lists = _alphas_neighbor_lists;
+        auto new_neighbor_lists = _neighbor_lists;
+        const int added_alpha_size = _added_alpha_size;
+        Kokkos::parallel_for("repack alphas", Kokkos::RangePolicy<device_execution_space>(0, number_of_targets), KOKKOS_LAMBDA(const int i) {
+            if (!is_dirty(i)) {
+                const global_index_type old_start = (old_neighbor_lists.getRowOffsetDevice(i) + TO_GLOBAL(i*added_alpha_size))*alphas_per_neighbor;
+                const global_index_type new_start = (new_neighbor_lists.getRowOffsetDevice(i) + TO_GLOBAL(i*added_alpha_size))*alphas_per_neighbor;
+                const global_index_type block_size = TO_GLOBAL(new_neighbor_lists.getNumberOfNeighborsDevice(i) + added_alpha_size)*alphas_per_neighbor;
+                for (global_index_type j=0; j<block_size; ++j) {
+                    repacked_alphas(new_start+j) = alphas(old_start+j);
+                }
+            }
+        });
+        Kokkos::fence();
+        _alphas = repacked_alphas;
+
+    }
+
+    this->generateCoefficientsForTargetsByOrder(number_of_batches, false /* keep_coefficients */, dirty_targets, true /* regenerating */);
+    this->finalizeAlphas();
+
+}
+
+bool GMLS::canDeduplicateStencils(const bool keep_coefficients) const {
+
+    if (_stencil_deduplication_tolerance <= 0 || keep_coefficients) return false;
+
+    // neighborhoods are only compared by coordinates, so nothing else may vary between target sites
+    bool can_deduplicate = (_problem_type == ProblemType::STANDARD)
+        && (_constraint_type == ConstraintType::NO_CONSTRAINT)
+        && (_max_evaluation_sites_per_target == 1)
+        && (_polynomial_sampling_functional == PointSample || _polynomial_sampling_functional == VectorPointSample)
+        && (_data_sampling_functional == PointSample || _data_sampling_functional == VectorPointSample)
+        && (_reconstruction_space != ReconstructionSpace::DivergenceFreeVectorTaylorPolynomial);
+
+    // alphas of each target operation must scale with epsilon
+    for (size_t i=0; i<_lro.size(); ++i) {
+        can_deduplicate = can_deduplicate && (TargetOperationDerivativeOrder[(int)_lro[i]] >= 0);
+    }
+
+    return can_deduplicate;
+
+}
+
+std::vector<int> GMLS::findStencilRepresentatives(Kokkos::View<int*>& representatives, 
+        Kokkos::View<int*>& neighbor_permutation) {
+
+    const int number_of_targets = _neighbor_lists.getNumberOfTargets();
+    const int dimensions = _dimensions;
+    const double tolerance = _stencil_deduplication_tolerance;
+    const global_index_type total_neighbors = _neighbor_lists.getTotalNeighborsOverAllListsHost();
+
+    // coordinates of each neighbor relative to the target site and divided by epsilon, in multiples of tolerance
+    Kokkos::View<long long int*> rounded_coordinates("rounded relative coordinates", total_neighbors*TO_GLOBAL(dimensions));
+    neighbor_permutation = Kokkos::View<int*>("stencil neighbor permutation", total_neighbors);
+    Kokkos::View<uint64_t*> stencil_hashes("stencil hashes", number_of_targets);
+
+    auto neighbor_lists = _neighbor_lists;
+    auto source_coordinates = _source_coordinates;
+    auto target_coordinates = _target_coordinates;
+    auto epsilons = _epsilons;
+    auto permutation = neighbor_permutation;
+    Kokkos::parallel_for("hash stencils", Kokkos::RangePolicy<device_execution_space>(0, number_of_targets), KOKKOS_LAMBDA(const int i) {
+        const int num_neighbors = neighbor_lists.getNumberOfNeighborsDevice(i);
+        const global_index_type offset = neighbor_lists.getRowOffsetDevice(i);
+        const double scale = 1.0/(epsilons(i)*tolerance);
+        for (int j=0; j<num_neighbors; ++j) {
+            const int neighbor = neighbor_lists.getNeighborDevice(i, j);
+            for (int d=0; d<dimensions; ++d) {
+                const double scaled_coordinate = (source_coordinates(neighbor, d) - target_coordinates(i, d))*scale;
+                rounded_coordinates((offset+j)*dimensions+d) = (long long int)((scaled_coordinate < 0) ? 
+                        scaled_coordinate - 0.5 : scaled_coordinate + 0.5);
+            }
+        }
+
+        // neighbors are sorted lexicographically by rounded coordinates, so that the order that 
+        // equivalent neighborhoods were listed in does not matter
+        auto less_than = [&](const int a, const int b) {
+            for (int d=0; d<dimensions; ++d) {
+                const long long int coordinate_a = rounded_coordinates((offset+a)*dimensions+d);
+                const long long int coordinate_b = rounded_coordinates((offset+b)*dimensions+d);
+                if (coordinate_a != coordinate_b) return coordinate_a < coordinate_b;
+            }
+            return false;
+        };
+        for (int j=0; j<num_neighbors; ++j) {
+            const int neighbor = j;
+            int k = j;
+            while (k > 0 && less_than(neighbor, permutation(offset+k-1))) {
+                permutation(offset+k) = permutation(offset+k-1);
+                --k;
+            }
+            permutation(offset+k) = neighbor;
+        }
+
+        // FNV-1a hash of the number of neighbors and sorted rounded coordinates
+        uint64_t hash = 14695981039346656037ULL;
+        hash = (hash ^ (uint64_t)num_neighbors) * 1099511628211ULL;
+        for (int j=0; j<num_neighbors; ++j) {
+            for (int d=0; d<dimensions; ++d) {
+                hash = (hash ^ (uint64_t)rounded_coordinates((offset+permutation(offset+j))*dimensions+d)) * 1099511628211ULL;
+            }
+        }
+        stencil_hashes(i) = hash;
+    });
+    Kokkos::fence();
+
+    // the first target site with each hash is the candidate representative for the others with that hash
+    auto host_stencil_hashes = Kokkos::create_mirror_view(stencil_hashes);
+    Kokkos::deep_copy(host_stencil_hashes, stencil_hashes);
+    representatives = Kokkos::View<int*>("stencil representatives", number_of_targets);
+    auto host_representatives = Kokkos::create_mirror_view(representatives);
+    std::unordered_map<uint64_t, int> first_target_with_hash;
+    first_target_with_hash.reserve(number_of_targets);
+    for (int i=0; i<number_of_targets; ++i) {
+        host_representatives(i) = first_target_with_hash.emplace(host_stencil_hashes(i), i).first->second;
+    }
+    Kokkos::deep_copy(representatives, host_representatives);
+
+    // hashes can collide, so rounded coordinates are compared, and target sites not matching 
+    // their candidate representative are solved for themselves
+    auto representative = representatives;
+    Kokkos::parallel_for("verify stencil representatives", Kokkos::RangePolicy<device_execution_space>(0, number_of_targets), KOKKOS_LAMBDA(const int i) {
+        const int r = representative(i);
+        if (r == i) return;
+        const int num_neighbors = neighbor_lists.getNumberOfNeighborsDevice(i);
+        bool same = (num_neighbors == neighbor_lists.getNumberOfNeighborsDevice(r));
+        const global_index_type offset_i = neighbor_lists.getRowOffsetDevice(i);
+        const global_index_type offset_r = neighbor_lists.getRowOffsetDevice(r);
+        for (int j=0; j<num_neighbors && same; ++j) {
+            for (int d=0; d<dimensions; ++d) {
+                same = same && (rounded_coordinates((offset_i+permutation(offset_i+j))*dimensions+d) 
+                        == rounded_coordinates((offset_r+permutation(offset_r+j))*dimensions+d));
+            }
+        }
+        if (!same) representative(i) = i;
+    });
+    Kokkos::fence();
+    Kokkos::deep_copy(host_representatives, representatives);
+
+    std::vector<int> solved_targets;
+    for (int i=0; i<number_of_targets; ++i) {
+        if (host_representatives(i) == i) solved_targets.push_back(i);
+    }
+    _number_of_deduplicated_targets = number_of_targets - (int)solved_targets.size();
+
+    // an empty list solves for all target sites
+    if (_number_of_deduplicated_targets == 0) solved_targets.clear();
+    return solved_targets;
+
+}
+
+void GMLS::copyAlphasFromRepresentatives(Kokkos::View<int*> representatives, Kokkos::View<int*> neighbor_permutation) {
+
+    const int number_of_targets = _neighbor_lists.getNumberOfTargets();
+    const int tiles_per_target = _total_alpha_values*_max_evaluation_sites_per_target;
+
+    // order of derivative of the target operation each alpha column offset belongs to
+    Kokkos::View<int*> column_derivative_order("column derivative order", tiles_per_target);
+    auto host_column_derivative_order = Kokkos::create_mirror_view(column_derivative_order);
+    for (size_t i=0; i<_lro.size(); ++i) {
+        const int columns = _host_lro_input_tile_size(i)*_host_lro_output_tile_size(i);
+        for (int j=0; j<columns; ++j) {
+            host_column_derivative_order(_host_lro_total_offsets(i) + j) = TargetOperationDerivativeOrder[(int)_lro[i]];
+        }
+    }
+    Kokkos::deep_copy(column_derivative_order, host_column_derivative_order);
+
+    auto alphas = _alphas;
+    auto neighbor_lists = _neighbor_lists;
+    auto epsilons = _epsilons;
+    Kokkos::parallel_for("copy alphas from stencil representatives", team_policy(number_of_targets, Kokkos::AUTO), 
+            KOKKOS_LAMBDA(const member_type& teamMember) {
+        const int i = teamMember.league_rank();
+        const int r = representatives(i);
+        if (r == i) return;
+        const int num_neighbors = neighbor_lists.getNumberOfNeighborsDevice(i);
+        const global_index_type offset_i = neighbor_lists.getRowOffsetDevice(i);
+        const global_index_type offset_r = neighbor_lists.getRowOffsetDevice(r);
+        const double epsilon_ratio = epsilons(r)/epsilons(i);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, tiles_per_target), [&](const int j) {
+            double factor = 1.0;
+            for (int k=0; k<column_derivative_order(j); ++k) factor *= epsilon_ratio;
+            // no constraints, so there are no added alphas before or within any tile
+            const global_index_type tile_i = offset_i*TO_GLOBAL(tiles_per_target) + TO_GLOBAL(j*num_neighbors);
+            const global_index_type tile_r = offset_r*TO_GLOBAL(tiles_per_target) + TO_GLOBAL(j*num_neighbors);
+            for (int k=0; k<num_neighbors; ++k) {
+                alphas(tile_i + neighbor_permutation(offset_i+k)) = factor*alphas(tile_r + neighbor_permutation(offset_r+k));
+            }
+        });
+    });
+    Kokkos::fence();
+
+}
+
+void GMLS::compressAlphas() {
+
+    const int number_of_targets = _neighbor_lists.getNumberOfTargets();
+    const int tiles_per_target = _total_alpha_values*_max_evaluation_sites_per_target;
+    const global_index_type number_of_alphas = _alphas.extent(0);
+    const bool scaled = (_alpha_storage_type == AlphaStorageType::ScaledInt16Alphas);
+
+    try {
+        if (scaled) {
+            _int16_alphas = decltype(_int16_alphas)("int16 alphas", number_of_alphas);
+            _alpha_scales = decltype(_alpha_scales)("alpha scales", TO_GLOBAL(number_of_targets)*TO_GLOBAL(tiles_per_target));
+        } else {
+            _float_alphas = decltype(_float_alphas)("float alphas", number_of_alphas);
+        }
+    } catch(std::exception &e) {
+       printf("Insufficient memory to store compressed alphas: \n\n%s", e.what()); 
+       throw e;
+    }
+
+    auto alphas = _alphas;
+    auto float_alphas = _float_alphas;
+    auto int16_alphas = _int16_alphas;
+    auto alpha_scales = _alpha_scales;
+    auto neighbor_lists = _alphas_neighbor_lists;
+    const int added_alpha_size = _added_alpha_size;
+    Kokkos::parallel_for("compress alphas", team_policy(number_of_targets, Kokkos::AUTO), KOKKOS_LAMBDA(const member_type& teamMember) {
+        const int i = teamMember.league_rank();
+        const int tile_size = neighbor_lists.getNumberOfNeighborsDevice(i) + added_alpha_size;
+        const global_index_type start = (neighbor_lists.getRowOffsetDevice(i) + TO_GLOBAL(i*added_alpha_size))*TO_GLOBAL(tiles_per_target);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, tiles_per_target), [&](const int j) {
+            const global_index_type tile_start = start + TO_GLOBAL(j*tile_size);
+            if (scaled) {
+                // largest alpha in magnitude in the tile maps to the largest 16-bit integer
+                double max_alpha = 0;
+                for (int k=0; k<tile_size; ++k) {
+                    const double abs_alpha = (alphas(tile_start+k) < 0) ? -alphas(tile_start+k) : alphas(tile_start+k);
+                    max_alpha = (abs_alpha > max_alpha) ? abs_alpha : max_alpha;
+                }
+                const double scale = max_alpha / 32767.0;
+                alpha_scales(TO_GLOBAL(i)*TO_GLOBAL(tiles_per_target) + TO_GLOBAL(j)) = scale;
+                for (int k=0; k<tile_size; ++k) {
+                    const double scaled_alpha = (scale > 0) ? alphas(tile_start+k) / scale : 0;
+                    int16_alphas(tile_start+k) = (int16_t)((scaled_alpha < 0) ? scaled_alpha - 0.5 : scaled_alpha + 0.5);
+                }
+            } else {
+                for (int k=0; k<tile_size; ++k) {
+                    float_alphas(tile_start+k) = (float)alphas(tile_start+k);
+                }
+            }
+        });
+    });
+    Kokkos::fence();
+
+    if (scaled) {
+        _host_alpha_scales = Kokkos::create_mirror_view(_alpha_scales);
+        Kokkos::deep_copy(_host_alpha_scales, _alpha_scales);
+    }
+
+    _alphas = decltype(_alphas)("alphas", 0);
+    _stored_alpha_type = _alpha_storage_type;
+
+}
+
+Kokkos::View<double*, layout_right> GMLS::decodeAlphas() const {
+
+    const int number_of_targets = _neighbor_lists.getNumberOfTargets();
+    const int tiles_per_target = _total_alpha_values*_max_evaluation_sites_per_target;
+    const bool scaled = (_stored_alpha_type == AlphaStorageType::ScaledInt16Alphas);
+    const global_index_type number_of_alphas = (scaled) ? _int16_alphas.extent(0) : _float_alphas.extent(0);
+
+    decltype(_alphas) alphas("alphas", number_of_alphas);
+    auto float_alphas = _float_alphas;
+    auto int16_alphas = _int16_alphas;
+    auto alpha_scales = _alpha_scales;
+    auto neighbor_lists = _alphas_neighbor_lists;
+    const int added_alpha_size = _added_alpha_size;
+    Kokkos::parallel_for("decode alphas", team_policy(number_of_targets, Kokkos::AUTO), KOKKOS_LAMBDA(const member_type& teamMember) {
+        const int i = teamMember.league_rank();
+        const int tile_size = neighbor_lists.getNumberOfNeighborsDevice(i) + added_alpha_size;
+        const global_index_type start = (neighbor_lists.getRowOffsetDevice(i) + TO_GLOBAL(i*added_alpha_size))*TO_GLOBAL(tiles_per_target);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, tiles_per_target), [&](const int j) {
+            const global_index_type tile_start = start + TO_GLOBAL(j*tile_size);
+            if (scaled) {
+                const double scale = alpha_scales(TO_GLOBAL(i)*TO_GLOBAL(tiles_per_target) + TO_GLOBAL(j));
+                for (int k=0; k<tile_size; ++k) {
+                    alphas(tile_start+k) = scale*int16_alphas(tile_start+k);
+                }
+            } else {
+                for (int k=0; k<tile_size; ++k) {
+                    alphas(tile_start+k) = float_alphas(tile_start+k);
+                }
+            }
+        });
+    });
+    Kokkos::fence();
+
+    return alphas;
+
+}
+
+GMLSMemoryPlan GMLS::planBatches(const std::size_t memory_budget_in_bytes, const int max_number_of_neighbor_buckets) const {
+
+    compadre_assert_release((max_number_of_neighbor_buckets > 0) && "max_number_of_neighbor_buckets must be greater than zero.");
+    compadre_assert_release(((size_t)_neighbor_lists.getNumberOfTargets()==_target_coordinates.extent(0)) 
+            && "Neighbor lists not set in GMLS class before calling planBatches.");
+
+    GMLSMemoryPlan plan;
+    plan.budget_bytes = memory_budget_in_bytes;
+
+    /*
+     *    Storage Independent of Batching
+     */
+
+    // same derived quantities as generatePolynomialCoefficients, without modifying this object
+    int poly_order = (_polynomial_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample) ? _poly_order + 1 : _poly_order;
+    // with an order for each target site, sizes of the group with the highest order bound those of every group
+    if (_host_poly_orders.extent(0) > 0) {
+        poly_order = *std::max_element(_host_poly_orders.data(), _host_poly_orders.data() + _host_poly_orders.extent(0));
+    }
+    const int basis_multiplier = this->calculateBasisMultiplier(_reconstruction_space);
+    const int sampling_multiplier = this->calculateSamplingMultiplier(_reconstruction_space, _data_sampling_functional);
+    const int added_alpha_size = getAdditionalAlphaSizeFromConstraint(_dense_solver_type, _constraint_type);
+    const global_index_type number_of_targets = _target_coordinates.extent(0);
+
+    int this_num_cols, manifold_NP;
+    int team_scratch_size_a, team_scratch_size_b, thread_scratch_size_a, thread_scratch_size_b;
+    this->getProblemSizes(poly_order, basis_multiplier, sampling_multiplier, _max_num_neighbors, this_num_cols, manifold_NP,
+            team_scratch_size_a, team_scratch_size_b, thread_scratch_size_a, thread_scratch_size_b);
+
+    // small standard problems are solved in team scratch rather than in _P, _RHS, and _w
+    const bool fuse_standard_solve = this->canFuseStandardSolve(false /*keep_coefficients*/, sampling_multiplier*_max_num_neighbors, 
+            this_num_cols, team_scratch_size_a);
+    if (fuse_standard_solve) {
+        int fused_team_scratch_size_a, fused_team_scratch_size_b;
+        this->getFusedStandardSolveScratchSizes(sampling_multiplier*_max_num_neighbors, this_num_cols, 
+                fused_team_scratch_size_a, fused_team_scratch_size_b);
+        team_scratch_size_a += fused_team_scratch_size_a;
+        team_scratch_size_b += fused_team_scratch_size_b;
+    }
+    const bool solve_targets_first = this->solvesTargetsFirst(false /*keep_coefficients*/, sampling_multiplier*_max_num_neighbors);
+
+    const global_index_type total_neighbors = _neighbor_lists.getTotalNeighborsOverAllListsHost();
+    const global_index_type number_of_alphas = (total_neighbors + number_of_targets*TO_GLOBAL(added_alpha_size))
+        * TO_GLOBAL(_total_alpha_values) * TO_GLOBAL(_max_evaluation_sites_per_target);
+    plan.alphas_bytes = sizeof(double) * number_of_alphas;
+    // compressed alphas are allocated while double precision alphas still exist
+    if (_alpha_storage_type == AlphaStorageType::FloatAlphas) {
+        plan.alphas_bytes += sizeof(float) * number_of_alphas;
+    } else if (_alpha_storage_type == AlphaStorageType::ScaledInt16Alphas) {
+        plan.alphas_bytes += sizeof(int16_t) * number_of_alphas + sizeof(double) * number_of_targets
+            * TO_GLOBAL(_total_alpha_values) * TO_GLOBAL(_max_evaluation_sites_per_target);
+    }
+
+    auto sro = _data_sampling_functional;
+    plan.prestencil_weights_bytes = sizeof(double) * TO_GLOBAL(std::pow(2,sro.use_target_site_weights))
+        * ((sro.transform_type==DifferentEachTarget || sro.transform_type==DifferentEachNeighbor) ? number_of_targets : 1)
+        * ((sro.transform_type==DifferentEachNeighbor) ? TO_GLOBAL(_max_num_neighbors) : 1)
+        * ((sro.output_rank>0) ? TO_GLOBAL(_local_dimensions) : 1)
+        * ((sro.input_rank>0) ? TO_GLOBAL(_global_dimensions) : 1);
+
+    // _T, _manifold_metric_tensor_inverse, _manifold_curvature_coefficients, and _manifold_curvature_gradient
+    plan.manifold_bytes = (_problem_type == ProblemType::MANIFOLD) ? sizeof(double) * number_of_targets 
+        * TO_GLOBAL(_dimensions*_dimensions + (_dimensions-1)*(_dimensions-1) + manifold_NP + (_dimensions-1)) : 0;
+
+    // scratch is allocated for every team that can execute concurrently
+    const int threads_per_team = _pm.getDefaultThreads();
+    const global_index_type concurrent_teams = std::max(1, device_execution_space::concurrency() 
+            / (threads_per_team*_pm.getDefaultVectorLanes()));
+    const int kernel_scratch_size = team_scratch_size_a + team_scratch_size_b 
+            + threads_per_team*(thread_scratch_size_a + thread_scratch_size_b);
+
+    // the batched solvers request their own team scratch when launched, so the footprint is the larger
+    // of theirs and that of the assembly and target kernels
+    const int max_num_rows = sampling_multiplier*_max_num_neighbors;
+    const int added_coeff_size = getAdditionalCoeffSizeFromConstraintAndSpace(_dense_solver_type, _constraint_type, 
+            _reconstruction_space, _dimensions);
+    const bool factor_in_single_precision = (_precision_policy == PrecisionPolicy::MixedPrecision);
+    int solver_scratch_size = 0;
+    auto add_solver_scratch = [&](const bool cholesky, const int M, const int N, const int NRHS) {
+        int scratch_size_0, scratch_size_1;
+        if (cholesky) {
+            GMLS_LinearAlgebra::getBatchCholeskySolveScratchSizes(N, NRHS, factor_in_single_precision, scratch_size_0, scratch_size_1);
+        } else {
+            GMLS_LinearAlgebra::getBatchQRPivotingSolveScratchSizes(M, N, NRHS, scratch_size_0, scratch_size_1);
+        }
+        solver_scratch_size = std::max(solver_scratch_size, scratch_size_0 + scratch_size_1);
+    };
+    const bool use_cholesky = (_dense_solver_type == DenseSolverType::Cholesky);
+    if (_problem_type == ProblemType::MANIFOLD) {
+        add_solver_scratch(use_cholesky, _max_num_neighbors, manifold_NP, _max_num_neighbors);
+        add_solver_scratch(use_cholesky, max_num_rows, this_num_cols, max_num_rows);
+    } else if (!fuse_standard_solve) {
+        if (_constraint_type != ConstraintType::NO_CONSTRAINT) {
+            add_solver_scratch(false, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + added_alpha_size);
+        } else if (use_cholesky) {
+            add_solver_scratch(true, this_num_cols, this_num_cols, 
+                    (solve_targets_first) ? _total_alpha_values*_max_evaluation_sites_per_target : max_num_rows);
+        } else {
+            add_solver_scratch(false, max_num_rows, this_num_cols, max_num_rows);
+        }
+    }
+
+    plan.team_scratch_bytes = concurrent_teams * TO_GLOBAL(std::max(kernel_scratch_size, solver_scratch_size));
+
+    /*
+     *    Storage Dependent on Batching
+     */
+
+    // fills in the batch dependent part of a plan, returning whether it fits in the budget
+    const bool pipelined = _pipeline_batches && ParallelManager::hasIndependentExecutionSpaces()
+        && (_problem_type != ProblemType::MANIFOLD) && !fuse_standard_solve;
+    auto evaluate_plan = [&](const int number_of_batches, const int number_of_buckets, GMLSMemoryPlan& candidate) {
+        std::vector<global_index_type> batch_starts, batch_sizes;
+        std::vector<int> batch_max_num_neighbors, host_ordering;
+        this->determineBatches(number_of_batches, number_of_buckets, std::vector<int>(), host_ordering, batch_starts, batch_sizes, batch_max_num_neighbors);
+        global_index_type RHS_size, P_size, w_size;
+        this->getBatchStorageSizes(sampling_multiplier, this_num_cols, batch_sizes, batch_max_num_neighbors, RHS_size, P_size, w_size);
+        if (fuse_standard_solve) RHS_size = P_size = w_size = 0;
+        const global_index_type projected_targets_size = (solve_targets_first) ? 
+            this->getProjectedTargetsStorageSize(this_num_cols, batch_sizes) : 0;
+
+        const global_index_type number_of_buffers = (pipelined && batch_sizes.size() > 1) ? 2 : 1;
+        candidate.number_of_batches = number_of_batches;
+        candidate.number_of_neighbor_buckets = number_of_buckets;
+        candidate.number_of_kernel_batches = batch_sizes.size();
+        candidate.max_batch_size = (batch_sizes.size() > 0) ? *std::max_element(batch_sizes.begin(), batch_sizes.end()) : 0;
+        candidate.P_bytes = number_of_buffers * sizeof(double) * P_size;
+        candidate.RHS_bytes = number_of_buffers * sizeof(double) * RHS_size;
+        candidate.w_bytes = number_of_buffers * sizeof(double) * w_size;
+        candidate.projected_targets_bytes = number_of_buffers * sizeof(double) * projected_targets_size;
+        return candidate.totalBytes() <= memory_budget_in_bytes;
+    };
+
+    // for each number of buckets, find the fewest batches that fit (storage decreases monotonically as 
+    // batches are added), and keep the plan that needs the fewest batches overall
+    const int max_number_of_batches = std::max(1, (int)number_of_targets);
+    const int max_number_of_buckets = std::min(max_number_of_neighbor_buckets, max_number_of_batches);
+    bool found_plan = false;
+    for (int number_of_buckets=1; number_of_buckets<=max_number_of_buckets; ++number_of_buckets) {
+        GMLSMemoryPlan candidate = plan;
+        if (!evaluate_plan(max_number_of_batches, number_of_buckets, candidate)) continue;
+        int lower = 1, upper = max_number_of_batches;
+        while (lower < upper) {
+            const int middle = lower + (upper - lower) / 2;
+            if (evaluate_plan(middle, number_of_buckets, candidate)) {
+                upper = middle;
+            } else {
+                lower = middle + 1;
+            }
+        }
+        evaluate_plan(upper, number_of_buckets, candidate);
+        if (!found_plan || candidate.number_of_kernel_batches < plan.number_of_kernel_batches) {
+            plan = candidate;
+            found_plan = true;
+        }
+    }
+
+    // nothing fits, so report the smallest footprint possible
+    if (!found_plan) evaluate_plan(max_number_of_batches, max_number_of_buckets, plan);
+
+    return plan;
+
+}
+
+GMLSMemoryPlan GMLS::planBatchesUsingFreeMemory(const double fraction_of_free_memory, const int max_number_of_neighbor_buckets) const {
+
+    compadre_assert_release((fraction_of_free_memory > 0 && fraction_of_free_memory <= 1) 
+            && "fraction_of_free_memory must be in (0,1].");
+
+    std::size_t free_bytes = 0;
+#ifdef COMPADRE_USE_CUDA
+    std::size_t total_bytes = 0;
+    cudaMemGetInfo(&free_bytes, &total_bytes);
+#elif defined(_SC_AVPHYS_PAGES)
+    free_bytes = TO_GLOBAL(sysconf(_SC_AVPHYS_PAGES)) * TO_GLOBAL(sysconf(_SC_PAGE_SIZE));
+#endif
+    compadre_assert_release((free_bytes > 0) && "Unable to determine the amount of free memory on this device.");
+
+    return this->planBatches(static_cast<std::size_t>(fraction_of_free_memory*free_bytes), max_number_of_neighbor_buckets);
+
+}
+
+void GMLS::determineBatches(const int number_of_batches, const int number_of_buckets, const std::vector<int>& target_subset,
+        std::vector<int>& host_ordering, std::vector<global_index_type>& batch_starts, std::vector<global_index_type>& batch_sizes, 
+        std::vector<int>& batch_max_num_neighbors) const {
+
+    const bool use_subset = target_subset.size() > 0;
+    const global_index_type number_of_targets = (use_subset) ? target_subset.size() : _target_coordinates.extent(0);
+    const global_index_type max_batch_size = (number_of_targets + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
+
+    host_ordering.clear();
+    batch_starts.clear();
+    batch_sizes.clear();
+    batch_max_num_neighbors.clear();
+
+    if (number_of_buckets > 1 || use_subset) {
+
+        // order target sites (all, or only those in target_subset) by their number of neighbors
+        if (use_subset) {
+            host_ordering = target_subset;
+        } else {
+            host_ordering.resize(number_of_targets);
+            std::iota(host_ordering.begin(), host_ordering.end(), 0);
+        }
+        std::stable_sort(host_ordering.begin(), host_ordering.end(), [&](const int a, const int b) {
+            return _host_number_of_neighbors_list(a) < _host_number_of_neighbors_list(b);
+        });
+
+        // buckets have an equal number of target sites, and each bucket is broken up further 
+        // if it contains more than max_batch_size target sites
+        const global_index_type bucket_size = (number_of_targets + TO_GLOBAL(number_of_buckets) - 1) 
+            / TO_GLOBAL(number_of_buckets);
+        for (global_index_type bucket_start=0; bucket_start<number_of_targets; bucket_start+=bucket_size) {
+            const global_index_type bucket_end = std::min(bucket_start + bucket_size, number_of_targets);
+            // last target site in the bucket has the most neighbors
+            const int bucket_max_num_neighbors = _host_number_of_neighbors_list(host_ordering[bucket_end-1]);
+            for (global_index_type start=bucket_start; start<bucket_end; start+=max_batch_size) {
+                batch_starts.push_back(start);
+                batch_sizes.push_back(std::min(bucket_end-start, max_batch_size));
+                batch_max_num_neighbors.push_back(bucket_max_num_neighbors);
+            }
+        }
+
+    } else {
+
+        for (global_index_type start=0; start<number_of_targets; start+=max_batch_size) {
+            batch_starts.push_back(start);
+            batch_sizes.push_back(std::min(number_of_targets-start, max_batch_size));
+            batch_max_num_neighbors.push_back(_max_num_neighbors);
+        }
+
+    }
+}
+
+void GMLS::getBatchStorageSizes(const int sampling_multiplier, const int this_num_cols, 
+        const std::vector<global_index_type>& batch_sizes, const std::vector<int>& batch_max_num_neighbors,
+        global_index_type& RHS_size, global_index_type& P_size, global_index_type& w_size) const {
+
+    RHS_size = 0;
+    P_size = 0;
+    w_size = 0;
+    for (size_t batch_num=0; batch_num<batch_sizes.size(); ++batch_num) {
+        int RHS_dim_0, RHS_dim_1, P_dim_0, P_dim_1;
+        const int batch_max_num_rows = sampling_multiplier*batch_max_num_neighbors[batch_num];
+        getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, batch_max_num_rows, this_num_cols, RHS_dim_0, RHS_dim_1);
+        getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, batch_max_num_rows, this_num_cols, P_dim_0, P_dim_1);
+        RHS_size = std::max(RHS_size, batch_sizes[batch_num]*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1));
+        P_size = std::max(P_size, batch_sizes[batch_num]*TO_GLOBAL(P_dim_0)*TO_GLOBAL(P_dim_1));
+        w_size = std::max(w_size, batch_sizes[batch_num]*TO_GLOBAL(batch_max_num_rows));
+    }
+}
+
+global_index_type GMLS::getProjectedTargetsStorageSize(const int this_num_cols, 
+        const std::vector<global_index_type>& batch_sizes) const {
+
+    global_index_type max_batch_size = 0;
+    for (auto batch_size : batch_sizes) max_batch_size = std::max(max_batch_size, batch_size);
+    return max_batch_size*TO_GLOBAL(_total_alpha_values*_max_evaluation_sites_per_target)*TO_GLOBAL(this_num_cols);
+}
+
+void GMLS::getProblemSizes(const int poly_order, const int basis_multiplier, const int sampling_multiplier, 
+        const int max_num_neighbors, int& this_num_cols, int& manifold_NP, int& team_scratch_size_a, 
+        int& team_scratch_size_b, int& thread_scratch_size_a, int& thread_scratch_size_b) const {
+
+    team_scratch_size_a = 0;
+    team_scratch_size_b = 0;
+    thread_scratch_size_a = 0;
+    thread_scratch_size_b = 0;
+
+    const int max_num_rows = sampling_multiplier*max_num_neighbors;
+
+    if (_problem_type == ProblemType::MANIFOLD) {
+        // these dimensions differ in the case of manifolds
+        const int NP = this->getNP(poly_order, _dimensions-1, _reconstruction_space);
+        manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
+        const int max_manifold_NP = (manifold_NP > NP) ? manifold_NP : NP;
+        this_num_cols = basis_multiplier*max_manifold_NP;
+        const int max_poly_order = (poly_order > _curvature_poly_order) ? poly_order : _curvature_poly_order;
+        const int max_P_row_size = ((_dimensions-1)*manifold_NP > max_manifold_NP*_total_alpha_values*basis_multiplier) ? (_dimensions-1)*manifold_NP : max_manifold_NP*_total_alpha_values*basis_multiplier*_max_evaluation_sites_per_target;
+
+        /*
+         *    Calculate Scratch Space Allocations
+         */
+
+        team_scratch_size_b += scratch_matrix_right_type::shmem_size(_dimensions-1, _dimensions-1); // G
+        team_scratch_size_b += scratch_matrix_right_type::shmem_size(_dimensions, _dimensions); // PTP matrix
+        team_scratch_size_b += scratch_vector_type::shmem_size( (_dimensions-1)*max_num_neighbors ); // manifold_gradient
+        team_scratch_size_b += scratch_matrix_right_type::shmem_size(max_num_neighbors, 3); // neighbor coordinates relative to target
+
+        team_scratch_size_b += scratch_vector_type::shmem_size(max_num_neighbors*std::max(sampling_multiplier,basis_multiplier)); // t1 work vector for qr
+        team_scratch_size_b += scratch_vector_type::shmem_size(max_num_neighbors*std::max(sampling_multiplier,basis_multiplier)); // t2 work vector for qr
+
+        team_scratch_size_b += scratch_vector_type::shmem_size(max_P_row_size); // row of P matrix, one for each operator
+        thread_scratch_size_b += scratch_vector_type::shmem_size(max_manifold_NP*basis_multiplier); // delta, used for each thread
+        thread_scratch_size_b += scratch_vector_type::shmem_size((max_poly_order+1)*_global_dimensions); // temporary space for powers in basis
+        if (_data_sampling_functional == VaryingManifoldVectorPointSample) {
+            thread_scratch_size_b += scratch_vector_type::shmem_size(_dimensions*_dimensions); // temporary tangent calculations, used for each thread
+        }
+
+    } else  { // Standard GMLS
+
+        const int NP = this->getNP(poly_order, _dimensions, _reconstruction_space);
+        manifold_NP = 0;
+        this_num_cols = basis_multiplier*NP;
+
+        /*
+         *    Calculate Scratch Space Allocations
+         */
+
+        team_scratch_size_a += scratch_vector_type::shmem_size(max_num_rows); // t1 work vector for qr
+        team_scratch_size_a += scratch_vector_type::shmem_size(max_num_rows); // t2 work vector for qr
+        team_scratch_size_a += scratch_matrix_right_type::shmem_size(max_num_neighbors, 3); // neighbor coordinates relative to target
+
+        // row of P matrix, one for each operator
+        // +1 is for the original target site which always gets evaluated
+        team_scratch_size_b += scratch_vector_type::shmem_size(this_num_cols*_total_alpha_values*_max_evaluation_sites_per_target); 
+
+        thread_scratch_size_b += scratch_vector_type::shmem_size(this_num_cols); // delta, used for each thread
+        thread_scratch_size_b += scratch_vector_type::shmem_size((poly_order+1)*_global_dimensions); // temporary space for powers in basis
+    }
+}
+
+bool GMLS::hasFixedBasisAssembly() const {
+    // specializations exist for ScalarTaylorPolynomial sampled with PointSample
+    return (_reconstruction_space == ReconstructionSpace::ScalarTaylorPolynomial)
+        && (_polynomial_sampling_functional == PointSample)
+        && (_dimensions >= 2 && _dimensions <= 3)
+        && (_poly_order >= 1 && _poly_order <= 4);
+}
+
+void GMLS::launchAssembleStandardPsqrtW(const int batch_size) {
+
+    // indexed by [dimension-2][polynomial order-1]
+    typedef void (GMLS::*launcher_type)(const int);
+    static const launcher_type fixed_basis_launchers[2][4] = {
+        { &GMLS::launchAssembleStandardPsqrtWFixedBasis<2,1>, &GMLS::launchAssembleStandardPsqrtWFixedBasis<2,2>,
+          &GMLS::launchAssembleStandardPsqrtWFixedBasis<2,3>, &GMLS::launchAssembleStandardPsqrtWFixedBasis<2,4> },
+        { &GMLS::launchAssembleStandardPsqrtWFixedBasis<3,1>, &GMLS::launchAssembleStandardPsqrtWFixedBasis<3,2>,
+          &GMLS::launchAssembleStandardPsqrtWFixedBasis<3,3>, &GMLS::launchAssembleStandardPsqrtWFixedBasis<3,4> }
+    };
+
+    if (this->hasFixedBasisAssembly()) {
+        (this->*fixed_basis_launchers[_dimensions-2][_poly_order-1])(batch_size);
+    } else {
+        _pm.CallFunctorWithTeamThreads<AssembleStandardPsqrtW>(*this, batch_size);
+    }
+
+}
+
+template <int Dimension, int PolyOrder>
+void GMLS::launchAssembleStandardPsqrtWFixedBasis(const int batch_size) {
+    _pm.CallFunctorWithTeamThreads<AssembleStandardPsqrtWFixedBasis<Dimension,PolyOrder> >(*this, batch_size);
+}
+
+void GMLS::launchAssembleSolveApplyStandard(const int batch_size) {
+
+    // indexed by [dimension-2][polynomial order-1]
+    typedef void (GMLS::*launcher_type)(const int);
+    static const launcher_type fixed_basis_launchers[2][4] = {
+        { &GMLS::launchAssembleSolveApplyStandardFixedBasis<2,1>, &GMLS::launchAssembleSolveApplyStandardFixedBasis<2,2>,
+          &GMLS::launchAssembleSolveApplyStandardFixedBasis<2,3>, &GMLS::launchAssembleSolveApplyStandardFixedBasis<2,4> },
+        { &GMLS::launchAssembleSolveApplyStandardFixedBasis<3,1>, &GMLS::launchAssembleSolveApplyStandardFixedBasis<3,2>,
+          &GMLS::launchAssembleSolveApplyStandardFixedBasis<3,3>, &GMLS::launchAssembleSolveApplyStandardFixedBasis<3,4> }
+    };
+
+    if (this->hasFixedBasisAssembly()) {
+        (this->*fixed_basis_launchers[_dimensions-2][_poly_order-1])(batch_size);
+    } else {
+        this->launchAssembleSolveApplyStandardFixedBasis<0,0>(batch_size);
+    }
+
+}
+
+template <int Dimension, int PolyOrder>
+void GMLS::launchAssembleSolveApplyStandardFixedBasis(const int batch_size) {
+    _pm.CallFunctorWithTeamThreads<AssembleSolveApplyStandard<Dimension,PolyOrder> >(*this, batch_size);
+}
+
+void GMLS::getFusedStandardSolveScratchSizes(const int max_num_rows, const int this_num_cols, 
+        int& team_scratch_size_a, int& team_scratch_size_b) const {
+
+    // QR+Pivoting workspace
+    GMLS_LinearAlgebra::getTeamQRPivotingSolveScratchSizes(max_num_rows, this_num_cols, max_num_rows, 
+            team_scratch_size_a, team_scratch_size_b);
+
+    // tiles that would otherwise be in _P, _RHS, and _w
+    team_scratch_size_a += scratch_matrix_right_type::shmem_size(max_num_rows, this_num_cols); // P*sqrt(w)
+    team_scratch_size_a += scratch_matrix_right_type::shmem_size(this_num_cols, max_num_rows); // RHS, then coefficients
+    team_scratch_size_a += scratch_vector_type::shmem_size(max_num_rows); // w
+
+}
+
+bool GMLS::canFuseStandardSolve(const bool keep_coefficients, const int max_num_rows, const int this_num_cols, 
+        const int team_scratch_size_a) const {
+
+    if (!_fuse_standard_solve || keep_coefficients
+            || _problem_type != ProblemType::STANDARD
+            || _constraint_type != ConstraintType::NO_CONSTRAINT
+            || _dense_solver_type == DenseSolverType::Cholesky) return false;
+
+    // larger problems are factored with the blocked algorithm by batchQRPivotingSolve
+    if (this_num_cols >= GMLS_LinearAlgebra::qr_pivoting_blocked_threshold) return false;
+
+    int fused_team_scratch_size_a, fused_team_scratch_size_b;
+    this->getFusedStandardSolveScratchSizes(max_num_rows, this_num_cols, fused_team_scratch_size_a, fused_team_scratch_size_b);
+    return (team_scratch_size_a + fused_team_scratch_size_a <= fused_standard_solve_max_team_scratch_bytes);
+
+}
+
+bool GMLS::solvesTargetsFirst(const bool keep_coefficients, const int max_num_rows) const {
+
+    if (!_solve_targets_first || keep_coefficients
+            || _problem_type != ProblemType::STANDARD
+            || _constraint_type != ConstraintType::NO_CONSTRAINT
+            || _dense_solver_type != DenseSolverType::Cholesky) return false;
+
+    // one right hand side for each row of P_target_row, rather than for each row of P
+    return (_total_alpha_values*_max_evaluation_sites_per_target < max_num_rows);
+
+}
+
 
 KOKKOS_INLINE_FUNCTION
 void GMLS::operator()(const AssembleStandardPsqrtW&, const member_type& teamMember) const {
+    this->assembleStandardPsqrtW<0,0>(teamMember);
+}
+
+
+template <int Dimension, int PolyOrder>
+KOKKOS_INLINE_FUNCTION
+void GMLS::operator()(const AssembleStandardPsqrtWFixedBasis<Dimension,PolyOrder>&, const member_type& teamMember) const {
+    this->assembleStandardPsqrtW<Dimension,PolyOrder>(teamMember);
+}
+
+
+template <int Dimension, int PolyOrder>
+KOKKOS_INLINE_FUNCTION
+void GMLS::assembleStandardPsqrtW(const member_type& teamMember) const {
 
     /*
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
-    const int this_num_rows = _sampling_multiplier*this->getNNeighbors(target_index);
     const int this_num_cols = _basis_multiplier*_NP;
 
     int RHS_dim_0, RHS_dim_1;
@@ -472,31 +1502,69 @@ void GMLS::operator()(const AssembleStandardPsqrtW&, const member_type& teamMemb
     scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), this_num_cols);
     scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (_poly_order+1)*_global_dimensions);
 
+    this->assembleStandardPsqrtW<Dimension,PolyOrder>(teamMember, delta, thread_workspace, PsqrtW, RHS, w);
+}
+
+
+template <int Dimension, int PolyOrder>
+KOKKOS_INLINE_FUNCTION
+void GMLS::assembleStandardPsqrtW(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace,
+        scratch_matrix_right_type PsqrtW, scratch_matrix_right_type RHS, scratch_vector_type w) const {
+
+    /*
+     *    Dimensions
+     */
+
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
+
+    const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
+    const int this_num_rows = _sampling_multiplier*this->getNNeighbors(target_index);
+    const int this_num_cols = _basis_multiplier*_NP;
+
+    const int P_dim_0 = PsqrtW.extent(0), P_dim_1 = PsqrtW.extent(1);
+    const int RHS_dim_0 = RHS.extent(0), RHS_dim_1 = RHS.extent(1);
+
+    // zero this target's tiles, which may hold data from a previous batch, here rather than
+    // zeroing all of _P, _RHS, and _w in separate passes before each batch
+    double * P_data = PsqrtW.data();
+    double * RHS_data = RHS.data();
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,P_dim_0*P_dim_1), [&] (const int i) {
+        P_data[i] = 0;
+    });
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,RHS_dim_0*RHS_dim_1), [&] (const int i) {
+        RHS_data[i] = 0;
+    });
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,max_num_rows), [&] (const int i) {
+        w(i) = 0;
+    });
+    teamMember.team_barrier();
+
     /*
      *    Assemble P*sqrt(W) and sqrt(w)*Identity
      */
 
+    // gather neighbor coordinates relative to the target once, rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates);
+
     // creates the matrix sqrt(W)*P
-    this->createWeightsAndP(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions, _poly_order, true /*weight_p*/, NULL /*&V*/, _reconstruction_space, _polynomial_sampling_functional);
+    if (Dimension > 0) {
+        this->createWeightsAndPFixedBasis<Dimension,PolyOrder>(teamMember, PsqrtW, w, &relative_coordinates);
+    } else {
+        this->createWeightsAndP(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions, _poly_order, true /*weight_p*/, NULL /*&V*/, _reconstruction_space, _polynomial_sampling_functional, &relative_coordinates);
+    }
 
-    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::Cholesky)) {
         // fill in RHS with Identity * sqrt(weights)
         double * rhs_data = RHS.data();
         Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,this_num_rows), [&] (const int i) {
             rhs_data[i] = std::sqrt(w(i));
         });
     } else {
-        // create global memory for matrix M = PsqrtW^T*PsqrtW
+        // matrix M = PsqrtW^T*PsqrtW is stored in RHS
         // don't need to cast into scratch_matrix_left_type since the matrix is symmetric
-        scratch_matrix_right_type M(_RHS.data()
-            + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
-        KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-	      ::invoke(teamMember,
-	    	   1.0,
-	    	   PsqrtW,
-	    	   PsqrtW,
-	    	   0.0,
-	    	   M);
+        scratch_matrix_right_type M = RHS;
+        GMLS_LinearAlgebra::teamSymmetricRankKUpdate(teamMember, M, PsqrtW, this_num_rows, PsqrtW.extent(1));
         teamMember.team_barrier();
 
         // Multiply PsqrtW with sqrt(W) to get PW
@@ -546,8 +1614,8 @@ void GMLS::operator()(const ApplyStandardTargets&, const member_type& teamMember
 
     // Coefficients for polynomial basis have overwritten _RHS
     scratch_matrix_right_type Coeffs;
-    // if (_dense_solver_type != DenseSolverType::LU) {
-    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+    // if (_dense_solver_type != DenseSolverType::Cholesky) {
+    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::Cholesky)) {
         Coeffs = scratch_matrix_right_type(_RHS.data() 
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
     } else {
@@ -557,13 +1625,24 @@ void GMLS::operator()(const ApplyStandardTargets&, const member_type& teamMember
     scratch_vector_type w(_w.data() 
             + TO_GLOBAL(local_index)*TO_GLOBAL(max_num_rows), max_num_rows);
 
+    scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), this_num_cols);
+    scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (_poly_order+1)*_global_dimensions);
+
+    this->applyStandardTargets(teamMember, delta, thread_workspace, Coeffs, w);
+}
+
+
+KOKKOS_INLINE_FUNCTION
+void GMLS::applyStandardTargets(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace,
+        scratch_matrix_right_type Coeffs, scratch_vector_type w) const {
+
+    const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
+    const int this_num_cols = _basis_multiplier*_NP;
+
     scratch_vector_type t1(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows);
     scratch_vector_type t2(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows);
     scratch_matrix_right_type P_target_row(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _total_alpha_values*_max_evaluation_sites_per_target, this_num_cols);
 
-    scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), this_num_cols);
-    scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (_poly_order+1)*_global_dimensions);
-
     /*
      *    Apply Standard Target Evaluations to Polynomial Coefficients
      */
@@ -577,6 +1656,118 @@ void GMLS::operator()(const ApplyStandardTargets&, const member_type& teamMember
 }
 
 
+template <int Dimension, int PolyOrder>
+KOKKOS_INLINE_FUNCTION
+void GMLS::operator()(const AssembleSolveApplyStandard<Dimension,PolyOrder>&, const member_type& teamMember) const {
+
+    /*
+     *    Dimensions
+     */
+
+    const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
+    const int this_num_cols = _basis_multiplier*_NP;
+
+    /*
+     *    Data
+     */
+
+    // same tiles as in _P, _RHS, and _w for QR with no constraint, but in team scratch
+    scratch_matrix_right_type PsqrtW(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows, this_num_cols);
+    scratch_matrix_right_type RHS(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), this_num_cols, max_num_rows);
+    scratch_vector_type w(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows);
+
+    // delta, used for each thread
+    scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), this_num_cols);
+    scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (_poly_order+1)*_global_dimensions);
+
+    /*
+     *    Assemble, Solve, and Apply Standard Target Evaluations
+     */
+
+    this->assembleStandardPsqrtW<Dimension,PolyOrder>(teamMember, delta, thread_workspace, PsqrtW, RHS, w);
+    teamMember.team_barrier();
+
+    // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
+    GMLS_LinearAlgebra::teamQRPivotingSolve(teamMember, PsqrtW, RHS, max_num_rows, this_num_cols, max_num_rows,
+            _pm.getTeamScratchLevel(0), _pm.getTeamScratchLevel(1));
+
+    this->applyStandardTargets(teamMember, delta, thread_workspace, RHS, w);
+}
+
+
+KOKKOS_INLINE_FUNCTION
+void GMLS::operator()(const EvaluateStandardTargets&, const member_type& teamMember) const {
+
+    /*
+     *    Dimensions
+     */
+
+    const int local_index  = teamMember.league_rank();
+
+    const int this_num_cols = _basis_multiplier*_NP;
+    const int num_target_rows = _total_alpha_values*_max_evaluation_sites_per_target;
+
+    /*
+     *    Data
+     */
+
+    scratch_matrix_right_type P_target_row(_projected_targets.data()
+            + TO_GLOBAL(local_index)*TO_GLOBAL(num_target_rows)*TO_GLOBAL(this_num_cols), num_target_rows, this_num_cols);
+
+    scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), this_num_cols);
+    scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (_poly_order+1)*_global_dimensions);
+
+    /*
+     *    Evaluate Standard Targets
+     */
+
+    this->computeTargetFunctionals(teamMember, delta, thread_workspace, P_target_row);
+    teamMember.team_barrier();
+}
+
+
+KOKKOS_INLINE_FUNCTION
+void GMLS::operator()(const ApplyProjectedStandardTargets&, const member_type& teamMember) const {
+
+    /*
+     *    Dimensions
+     */
+
+    const int local_index  = teamMember.league_rank();
+
+    const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
+    const int this_num_cols = _basis_multiplier*_NP;
+    const int num_target_rows = _total_alpha_values*_max_evaluation_sites_per_target;
+
+    int P_dim_0, P_dim_1;
+    getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
+
+    /*
+     *    Data
+     */
+
+    // P_target_row*(P^T*W*P)^-1
+    scratch_matrix_right_type projected_targets(_projected_targets.data()
+            + TO_GLOBAL(local_index)*TO_GLOBAL(num_target_rows)*TO_GLOBAL(this_num_cols), num_target_rows, this_num_cols);
+
+    // P*W is left in _P by assembly, so its transpose P^T*W takes the place of the coefficients
+    scratch_matrix_left_type PTW(_P.data()
+            + TO_GLOBAL(local_index)*TO_GLOBAL(P_dim_0)*TO_GLOBAL(P_dim_1), P_dim_1, P_dim_0);
+    scratch_vector_type w(_w.data() 
+            + TO_GLOBAL(local_index)*TO_GLOBAL(max_num_rows), max_num_rows);
+
+    scratch_vector_type t1(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows);
+    scratch_vector_type t2(teamMember.team_scratch(_pm.getTeamScratchLevel(0)), max_num_rows);
+
+    /*
+     *    Apply Projected Standard Targets to P^T*W
+     */
+
+    this->applyTargetsToCoefficients(teamMember, t1, t2, PTW, w, projected_targets, _NP);
+    teamMember.team_barrier();
+}
+
+
 KOKKOS_INLINE_FUNCTION
 void GMLS::operator()(const ComputeCoarseTangentPlane&, const member_type& teamMember) const {
 
@@ -584,7 +1775,7 @@ void GMLS::operator()(const ComputeCoarseTangentPlane&, const member_type& teamM
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -617,8 +1808,12 @@ void GMLS::operator()(const ComputeCoarseTangentPlane&, const member_type& teamM
      *    Determine Coarse Approximation of Manifold Tangent Plane
      */
 
+    // neighbor coordinates relative to the target, gathered once rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates);
+
     // getting x y and z from which to derive a manifold
-    this->createWeightsAndPForCurvature(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions, true /* only specific order */);
+    this->createWeightsAndPForCurvature(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions, true /* only specific order */, NULL /*&T*/, &relative_coordinates);
 
     // create PsqrtW^T*PsqrtW
     KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
@@ -645,7 +1840,7 @@ void GMLS::operator()(const AssembleCurvaturePsqrtW&, const member_type& teamMem
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -682,14 +1877,18 @@ void GMLS::operator()(const AssembleCurvaturePsqrtW&, const member_type& teamMem
     //  RECONSTRUCT ON THE TANGENT PLANE USING LOCAL COORDINATES
     //
 
+    // neighbor coordinates relative to the target in local coordinates, gathered once rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates, &T);
+
     // creates the matrix sqrt(W)*P
-    this->createWeightsAndPForCurvature(teamMember, delta, thread_workspace, CurvaturePsqrtW, w, _dimensions-1, false /* only specific order */, &T);
+    this->createWeightsAndPForCurvature(teamMember, delta, thread_workspace, CurvaturePsqrtW, w, _dimensions-1, false /* only specific order */, &T, &relative_coordinates);
     teamMember.team_barrier();
 
     // CurvaturePsqrtW is sized according to max_num_rows x this_num_cols of which in this case
     // we are only using this_num_neighbors x manifold_NP
 
-    if (_dense_solver_type != DenseSolverType::LU) {
+    if (_dense_solver_type != DenseSolverType::Cholesky) {
         // fill in RHS with Identity * sqrt(weights)
         double * rhs_data = RHS.data();
         Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,this_num_neighbors), [&] (const int i) {
@@ -701,13 +1900,7 @@ void GMLS::operator()(const AssembleCurvaturePsqrtW&, const member_type& teamMem
         scratch_matrix_right_type M(_RHS.data()
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
         // Assemble matrix M
-        KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-          ::invoke(teamMember,
-               1.0,
-               CurvaturePsqrtW,
-               CurvaturePsqrtW,
-               0.0,
-               M);
+        GMLS_LinearAlgebra::teamSymmetricRankKUpdate(teamMember, M, CurvaturePsqrtW, this_num_neighbors, CurvaturePsqrtW.extent(1));
         teamMember.team_barrier();
 
         // Multiply PsqrtW with sqrt(W) to get PW
@@ -727,7 +1920,7 @@ void GMLS::operator()(const GetAccurateTangentDirections&, const member_type& te
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -745,7 +1938,7 @@ void GMLS::operator()(const GetAccurateTangentDirections&, const member_type& te
      *    Data
      */
     scratch_matrix_right_type Q;
-    if (_dense_solver_type != DenseSolverType::LU) {
+    if (_dense_solver_type != DenseSolverType::Cholesky) {
         // Solution from QR comes from RHS
         Q = scratch_matrix_right_type(_RHS.data()
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
@@ -777,6 +1970,10 @@ void GMLS::operator()(const GetAccurateTangentDirections&, const member_type& te
     this->computeCurvatureFunctionals(teamMember, delta, thread_workspace, P_target_row, &T);
     teamMember.team_barrier();
 
+    // neighbor coordinates relative to the target in local coordinates, gathered once rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates, &T);
+
     double grad_xi1 = 0, grad_xi2 = 0;
     for (int i=0; i<this->getNNeighbors(target_index); ++i) {
         for (int k=0; k<_dimensions-1; ++k) {
@@ -795,7 +1992,7 @@ void GMLS::operator()(const GetAccurateTangentDirections&, const member_type& te
         }
         teamMember.team_barrier();
 
-        XYZ rel_coord = getRelativeCoord(target_index, i, _dimensions, &T);
+        XYZ rel_coord = getRelativeCoord(i, _dimensions, relative_coordinates);
         double normal_coordinate = rel_coord[_dimensions-1];
 
         // apply coefficients to sample data
@@ -881,7 +2078,7 @@ void GMLS::operator()(const FixTangentDirectionOrdering&, const member_type& tea
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 
     /*
      *    Data
@@ -926,7 +2123,7 @@ void GMLS::operator()(const ApplyCurvatureTargets&, const member_type& teamMembe
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -944,7 +2141,7 @@ void GMLS::operator()(const ApplyCurvatureTargets&, const member_type& teamMembe
      *    Data
      */
     scratch_matrix_right_type Q;
-    if (_dense_solver_type != DenseSolverType::LU) {
+    if (_dense_solver_type != DenseSolverType::Cholesky) {
         // Solution from QR comes from RHS
         Q = scratch_matrix_right_type(_RHS.data()
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
@@ -982,6 +2179,10 @@ void GMLS::operator()(const ApplyCurvatureTargets&, const member_type& teamMembe
     this->computeCurvatureFunctionals(teamMember, delta, thread_workspace, P_target_row, &T);
     teamMember.team_barrier();
 
+    // neighbor coordinates relative to the target in local coordinates, gathered once rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates, &T);
+
     Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
         for (int j=0; j<manifold_NP; ++j) { // set to zero
             manifold_coeffs(j) = 0;
@@ -1007,7 +2208,7 @@ void GMLS::operator()(const ApplyCurvatureTargets&, const member_type& teamMembe
         }
         teamMember.team_barrier();
 
-        XYZ rel_coord = getRelativeCoord(target_index, i, _dimensions, &T);
+        XYZ rel_coord = getRelativeCoord(i, _dimensions, relative_coordinates);
         double normal_coordinate = rel_coord[_dimensions-1];
 
         // apply coefficients to sample data
@@ -1071,7 +2272,7 @@ void GMLS::operator()(const AssembleManifoldPsqrtW&, const member_type& teamMemb
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -1108,10 +2309,14 @@ void GMLS::operator()(const AssembleManifoldPsqrtW&, const member_type& teamMemb
      *    Manifold
      */
 
-    this->createWeightsAndP(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions-1, _poly_order, true /* weight with W*/, &T, _reconstruction_space, _polynomial_sampling_functional);
+    // neighbor coordinates relative to the target in local coordinates, gathered once rather than indirectly through the neighbor list for each use
+    scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+    this->gatherRelativeCoordinates(teamMember, relative_coordinates, &T);
+
+    this->createWeightsAndP(teamMember, delta, thread_workspace, PsqrtW, w, _dimensions-1, _poly_order, true /* weight with W*/, &T, _reconstruction_space, _polynomial_sampling_functional, &relative_coordinates);
     teamMember.team_barrier();
 
-    if (_dense_solver_type != DenseSolverType::LU) {
+    if (_dense_solver_type != DenseSolverType::Cholesky) {
         // fill in RHS with Identity * sqrt(weights)
         double * Q_data = Q.data();
         Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,this_num_rows), [&] (const int i) {
@@ -1123,13 +2328,7 @@ void GMLS::operator()(const AssembleManifoldPsqrtW&, const member_type& teamMemb
         scratch_matrix_right_type M(_RHS.data()
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
         // Assemble matrix M
-        KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-	      ::invoke(teamMember,
-	    	   1.0,
-	    	   PsqrtW,
-	    	   PsqrtW,
-	    	   0.0,
-	    	   M);
+        GMLS_LinearAlgebra::teamSymmetricRankKUpdate(teamMember, M, PsqrtW, this_num_rows, PsqrtW.extent(1));
         teamMember.team_barrier();
 
 
@@ -1150,7 +2349,7 @@ void GMLS::operator()(const ApplyManifoldTargets&, const member_type& teamMember
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -1169,7 +2368,7 @@ void GMLS::operator()(const ApplyManifoldTargets&, const member_type& teamMember
      */
 
     scratch_matrix_right_type Coeffs;
-    if (_dense_solver_type != DenseSolverType::LU) {
+    if (_dense_solver_type != DenseSolverType::Cholesky) {
         Coeffs = scratch_matrix_right_type(_RHS.data() 
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
     } else {
@@ -1214,7 +2413,7 @@ void GMLS::operator()(const ComputePrestencilWeights&, const member_type& teamMe
      *    Dimensions
      */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int local_index  = teamMember.league_rank();
 
     const int max_num_rows = _sampling_multiplier*_max_num_neighbors;
@@ -1238,7 +2437,7 @@ void GMLS::operator()(const ComputePrestencilWeights&, const member_type& teamMe
 
     // holds polynomial coefficients for curvature reconstruction
     scratch_matrix_right_type Q;
-    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+    if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::Cholesky)) {
         // Solution from QR comes from RHS
         Q = scratch_matrix_right_type(_RHS.data()
             + TO_GLOBAL(local_index)*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1), RHS_dim_0, RHS_dim_1);
@@ -1299,14 +2498,18 @@ void GMLS::operator()(const ComputePrestencilWeights&, const member_type& teamMe
         });
     } else if (_data_sampling_functional == VaryingManifoldVectorPointSample) {
 
+        // neighbor coordinates relative to the target in local coordinates, gathered once since each neighbor
+        // reconstructs a gradient from the normal coordinates of all neighbors
+        scratch_matrix_right_type relative_coordinates(teamMember.team_scratch(_pm.getTeamScratchLevel(1)), _max_num_neighbors, 3);
+        this->gatherRelativeCoordinates(teamMember, relative_coordinates, &T);
+
         scratch_vector_type delta(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), manifold_NP);
         scratch_vector_type thread_workspace(teamMember.thread_scratch(_pm.getThreadScratchLevel(1)), (max_poly_order+1)*_global_dimensions);
 
         Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember,this->getNNeighbors(target_index)), [&] (const int m) {
             
-            Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-                this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, m, 0 /*alpha*/, 0 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, &T, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
-            });
+            // evaluated by all vector lanes of this thread, which the basis evaluation is spread over
+            this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, m, 0 /*alpha*/, 0 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, &T, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
             // reconstructs gradient at local neighbor index m
             double grad_xi1 = 0, grad_xi2 = 0;
             Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember,this->getNNeighbors(target_index)), [=] (const int i, double &t_grad_xi1) {
@@ -1314,7 +2517,7 @@ void GMLS::operator()(const ComputePrestencilWeights&, const member_type& teamMe
                 for (int l=0; l<manifold_NP; ++l) {
                     alpha_ij += delta(l)*Q(l,i);
                 }
-                XYZ rel_coord = getRelativeCoord(target_index, i, _dimensions, &T);
+                XYZ rel_coord = getRelativeCoord(i, _dimensions, relative_coordinates);
                 double normal_coordinate = rel_coord[_dimensions-1];
 
                 // apply coefficients to sample data
@@ -1322,15 +2525,13 @@ void GMLS::operator()(const ComputePrestencilWeights&, const member_type& teamMe
             }, grad_xi1);
             t1(m) = grad_xi1;
 
-            Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-                this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, m, 0 /*alpha*/, 1 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, &T, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
-            });
+            this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, m, 0 /*alpha*/, 1 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, &T, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
             Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember,this->getNNeighbors(target_index)), [=] (const int i, double &t_grad_xi2) {
                 double alpha_ij = 0;
                 for (int l=0; l<manifold_NP; ++l) {
                     alpha_ij += delta(l)*Q(l,i);
                 }
-                XYZ rel_coord = getRelativeCoord(target_index, i, _dimensions, &T);
+                XYZ rel_coord = getRelativeCoord(i, _dimensions, relative_coordinates);
                 double normal_coordinate = rel_coord[_dimensions-1];
 
                 // apply coefficients to sample data
@@ -13,8 +13,76 @@
 #include "Compadre_DivergenceFreePolynomial.hpp"
 #include "Compadre_NeighborLists.hpp"
 
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
 namespace Compadre {
 
+//! Largest team scratch (in bytes, at the lower team scratch level) with which a STANDARD problem is
+//! assembled, solved, and has targets applied in a single kernel (see GMLS::setFuseStandardSolve)
+const int fused_standard_solve_max_team_scratch_bytes = 48*1024;
+
+//!  Device memory needed by GMLS::generateAlphas for a choice of batches and neighbor buckets
+/*!
+*  Returned by GMLS::planBatches before anything is allocated, and passed to GMLS::generateAlphas
+*  to use the number of batches and neighbor buckets that it chose.
+*/
+struct GMLSMemoryPlan {
+
+    //! number_of_batches to pass to generateAlphas
+    int number_of_batches;
+
+    //! number of buckets to pass to setNumberOfNeighborBuckets
+    int number_of_neighbor_buckets;
+
+    //! number of batches actually solved (each bucket is broken up into batches)
+    int number_of_kernel_batches;
+
+    //! largest number of target sites solved at once
+    global_index_type max_batch_size;
+
+    //! bytes needed for storage (in device memory space)
+    std::size_t alphas_bytes, prestencil_weights_bytes, manifold_bytes, P_bytes, RHS_bytes, w_bytes, projected_targets_bytes;
+
+    //! bytes of scratch needed for all teams that may execute concurrently
+    std::size_t team_scratch_bytes;
+
+    //! budget the plan was made for
+    std::size_t budget_bytes;
+
+    GMLSMemoryPlan() : number_of_batches(1), number_of_neighbor_buckets(1), number_of_kernel_batches(0), 
+        max_batch_size(0), alphas_bytes(0), prestencil_weights_bytes(0), manifold_bytes(0), P_bytes(0), 
+        RHS_bytes(0), w_bytes(0), projected_targets_bytes(0), team_scratch_bytes(0), budget_bytes(0) {}
+
+    std::size_t totalBytes() const {
+        return alphas_bytes + prestencil_weights_bytes + manifold_bytes + P_bytes + RHS_bytes + w_bytes 
+            + projected_targets_bytes + team_scratch_bytes;
+    }
+
+    bool fitsBudget() const { return totalBytes() <= budget_bytes; }
+
+    //! Prints the plan and its footprint in MB to os
+    void print(std::ostream& os) const {
+        const double MB = 1024.0*1024.0;
+        const std::ios::fmtflags flags = os.flags();
+        const std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(2);
+        os << "GMLS memory plan: " << number_of_batches << " batches, " << number_of_neighbor_buckets 
+           << " neighbor buckets (" << number_of_kernel_batches << " batches solved, at most " << max_batch_size 
+           << " target sites each)" << std::endl;
+        os << "  alphas: " << alphas_bytes/MB << " MB, prestencil weights: " << prestencil_weights_bytes/MB 
+           << " MB, manifold: " << manifold_bytes/MB << " MB" << std::endl;
+        os << "  P: " << P_bytes/MB << " MB, RHS: " << RHS_bytes/MB << " MB, w: " << w_bytes/MB 
+           << " MB, projected targets: " << projected_targets_bytes/MB << " MB, scratch: " << team_scratch_bytes/MB 
+           << " MB" << std::endl;
+        os << "  total: " << totalBytes()/MB << " MB of " << budget_bytes/MB << " MB budget" 
+           << ((fitsBudget()) ? "" : " (DOES NOT FIT)") << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+};
+
 //!  Generalized Moving Least Squares (GMLS)
 /*!
 *  This class sets up a batch of GMLS problems from a given set of neighbor lists, target sites, and source sites.
@@ -40,6 +108,10 @@ protected:
     //! sqrt(w)*Identity matrix for all problems, later holds polynomial coefficients for all problems
     Kokkos::View<double*> _RHS;
 
+    //! evaluations of target functionals for all problems, later holding them multiplied by (P^T*W*P)^-1, 
+    //! when targets are solved for before being applied to P^T*W (see solvesTargetsFirst)
+    Kokkos::View<double*> _projected_targets;
+
     //! Rank 3 tensor for high order approximation of tangent vectors for all problems. First rank is
     //! for the target index, the second is for the local direction to the manifolds 0..(_dimensions-1)
     //! are tangent, _dimensions is the normal, and the third is for the spatial dimension (_dimensions)
@@ -88,11 +160,25 @@ protected:
     //! h supports determined through neighbor search (host)
     Kokkos::View<double*>::HostMirror _host_epsilons; 
 
-    //! generated alpha coefficients (device)
+    //! generated alpha coefficients (device), empty once compressed into another AlphaStorageType
     Kokkos::View<double*, layout_right> _alphas; 
 
-    //! generated alpha coefficients (host)
-    Kokkos::View<const double*, layout_right>::HostMirror _host_alphas;
+    //! generated alpha coefficients stored in single precision (device), used with FloatAlphas
+    Kokkos::View<float*, layout_right> _float_alphas; 
+
+    //! generated alpha coefficients stored as 16-bit integers to be multiplied by _alpha_scales 
+    //! (device), used with ScaledInt16Alphas
+    Kokkos::View<int16_t*, layout_right> _int16_alphas; 
+
+    //! scale of each tile of _int16_alphas, indexed by target site and then alpha column offset (device)
+    Kokkos::View<double*, layout_right> _alpha_scales; 
+
+    //! scales of _alpha_scales (host), copied once when alphas are compressed
+    Kokkos::View<double*, layout_right>::HostMirror _host_alpha_scales; 
+
+    //! generated alpha coefficients (host), copied from _alphas at the end of generateAlphas 
+    //! or on first host access if _lazy_host_alphas is true
+    mutable Kokkos::View<const double*, layout_right>::HostMirror _host_alphas;
     
     //! generated weights for nontraditional samples required to transform data into expected sampling 
     //! functional form (device). 
@@ -118,6 +204,9 @@ protected:
     //! order of basis for polynomial reconstruction
     int _poly_order; 
 
+    //! (OPTIONAL) order of basis for polynomial reconstruction at each target site, overriding _poly_order
+    Kokkos::View<int*, host_memory_space> _host_poly_orders;
+
     //! order of basis for curvature reconstruction
     int _curvature_poly_order;
 
@@ -139,9 +228,18 @@ protected:
     //! actual rank of reconstruction basis
     int _reconstruction_space_rank;
 
-    //! solver type for GMLS problem - can be QR, SVD or LU
+    //! solver type for GMLS problem - can be QR or Cholesky
     DenseSolverType _dense_solver_type;
 
+    //! floating point precision used when factoring P^T*W*P (only with Cholesky)
+    PrecisionPolicy _precision_policy;
+
+    //! storage format that alphas are compressed into after the next generation
+    AlphaStorageType _alpha_storage_type;
+
+    //! storage format of the alphas currently generated
+    AlphaStorageType _stored_alpha_type;
+
     //! problem type for GMLS problem, can also be set to STANDARD for normal or MANIFOLD for manifold problems
     ProblemType _problem_type;
 
@@ -219,6 +317,43 @@ protected:
     //! maximum number of neighbors over all target sites
     int _max_num_neighbors;
 
+    //! number of buckets that target sites are grouped into by their number of neighbors
+    int _number_of_neighbor_buckets;
+
+    //! spacing (relative to epsilon) that neighbor coordinates relative to the target site are rounded to 
+    //! when finding neighborhoods that are translations and scalings of one another. 0 if not deduplicating
+    double _stencil_deduplication_tolerance;
+
+    //! number of target sites whose alphas were copied from an equivalent target site in the last generation
+    int _number_of_deduplicated_targets;
+
+    //! (OPTIONAL) permutation of target indices ordered by number of neighbors, used to process 
+    //! target sites with similar numbers of neighbors together (device). Empty if targets are
+    //! processed in their original order.
+    Kokkos::View<int*> _target_ordering;
+
+    //! neighbor lists that _alphas was laid out with when it was last generated, used to 
+    //! move alphas of other target sites when target sites are regenerated with different neighbors
+    NeighborLists<Kokkos::View<int*> > _alphas_neighbor_lists;
+
+    //! whether batches of standard problems alternate between two sets of _P, _RHS, and _w, 
+    //! each launched on its own execution space instance
+    bool _pipeline_batches;
+
+    //! whether small STANDARD problems are assembled, solved, and have targets applied in a single 
+    //! kernel using team scratch, rather than in _P, _RHS, and _w
+    bool _fuse_standard_solve;
+
+    //! whether STANDARD problems solved with LU whose coefficients are not kept solve the normal 
+    //! equations against the target functionals rather than against P^T*W
+    bool _solve_targets_first;
+
+    //! whether _host_alphas is only copied from _alphas when first needed on the host
+    bool _lazy_host_alphas;
+
+    //! whether _host_alphas holds the alphas most recently generated in _alphas
+    mutable bool _host_alphas_synced;
+
     //! maximum number of evaluation sites for each target (includes target site)
     int _max_evaluation_sites_per_target;
 
@@ -299,9 +434,10 @@ protected:
         \param reconstruction_space [in] - space of polynomial that a sampling functional is to evaluate
         \param sampling_strategy    [in] - sampling functional specification
         \param additional_evaluation_local_index [in] - local index for evaluation sites 
+        \param relative_coordinates [in] - (OPTIONAL) neighbor coordinates relative to the target from gatherRelativeCoordinates(...), in the same frame as V
     */
     KOKKOS_INLINE_FUNCTION
-    void calcPij(const member_type& teamMember, double* delta, double* thread_workspace, const int target_index, int neighbor_index, const double alpha, const int dimension, const int poly_order, bool specific_order_only = false, const scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional sampling_strategy = PointSample, const int additional_evaluation_local_index = 0) const;
+    void calcPij(const member_type& teamMember, double* delta, double* thread_workspace, const int target_index, int neighbor_index, const double alpha, const int dimension, const int poly_order, bool specific_order_only = false, const scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional sampling_strategy = PointSample, const int additional_evaluation_local_index = 0, const scratch_matrix_right_type* relative_coordinates = NULL) const;
 
     /*! \brief Evaluates the gradient of a polynomial basis under the Dirac Delta (pointwise) sampling function.
         \param delta            [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large is the _basis_multipler*the dimension of the polynomial basis.
@@ -352,9 +488,25 @@ protected:
         \param V                    [in] - orthonormal basis matrix size _dimensions * _dimensions whose first _dimensions-1 columns are an approximation of the tangent plane
         \param reconstruction_space [in] - space of polynomial that a sampling functional is to evaluate
         \param sampling_strategy    [in] - sampling functional specification
+        \param relative_coordinates [in] - (OPTIONAL) neighbor coordinates relative to the target from gatherRelativeCoordinates(...), in the same frame as V
     */
     KOKKOS_INLINE_FUNCTION
-    void createWeightsAndP(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p = false, scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional sampling_strategy = PointSample) const;
+    void createWeightsAndP(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p = false, scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional sampling_strategy = PointSample, const scratch_matrix_right_type* relative_coordinates = NULL) const;
+
+    /*! \brief Fills the _P matrix with sqrt(w)*P for a ScalarTaylorPolynomial basis sampled with PointSample,
+        where the dimension and order of the basis are known at compile time
+
+        Equivalent to createWeightsAndP(...) with weight_p = true for that combination, but rows of P are
+        written directly rather than through thread scratch.
+
+        \param teamMember           [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param P                   [out] - 2D Kokkos View which will contain sqrt(w)*P for each neighbor the target has
+        \param w                   [out] - 1D Kokkos View which will contain weighting kernel values for the target with each neighbor
+        \param relative_coordinates [in] - (OPTIONAL) neighbor coordinates relative to the target from gatherRelativeCoordinates(...)
+    */
+    template <int Dimension, int PolyOrder>
+    KOKKOS_INLINE_FUNCTION
+    void createWeightsAndPFixedBasis(const member_type& teamMember, scratch_matrix_right_type P, scratch_vector_type w, const scratch_matrix_right_type* relative_coordinates = NULL) const;
 
     /*! \brief Fills the _P matrix with P*sqrt(w) for use in solving for curvature
 
@@ -368,9 +520,10 @@ protected:
         \param dimension            [in] - spatial dimension of basis to evaluate. e.g. dimension two basis of order one is 1, x, y, whereas for dimension 3 it is 1, x, y, z
         \param only_specific_order  [in] - boolean for only evaluating one degree of polynomial when true
         \param V                    [in] - orthonormal basis matrix size _dimensions * _dimensions whose first _dimensions-1 columns are an approximation of the tangent plane
+        \param relative_coordinates [in] - (OPTIONAL) neighbor coordinates relative to the target from gatherRelativeCoordinates(...), in the same frame as V
     */
     KOKKOS_INLINE_FUNCTION
-    void createWeightsAndPForCurvature(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, bool only_specific_order, scratch_matrix_right_type* V = NULL) const;
+    void createWeightsAndPForCurvature(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, bool only_specific_order, scratch_matrix_right_type* V = NULL, const scratch_matrix_right_type* relative_coordinates = NULL) const;
 
     /*! \brief Evaluates a polynomial basis with a target functional applied to each member of the basis
         \param teamMember                   [in] - Kokkos::TeamPolicy member type (created by parallel_for)
@@ -381,6 +534,44 @@ protected:
     KOKKOS_INLINE_FUNCTION
     void computeTargetFunctionals(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, scratch_matrix_right_type P_target_row) const;
 
+    /*! \brief Evaluates the value and first partial derivatives of the scalar Taylor polynomial basis once per
+        evaluation site, storing them in the rows of every target operation that is a point evaluation of them
+        (ScalarPointEvaluation, GradientOfScalarPointEvaluation, and Partial[X,Y,Z]OfScalarPointEvaluation)
+        \param teamMember                   [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param thread_workspace         [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large is the _poly_order*_global_dimensions.
+        \param P_target_row                [out] - 1D Kokkos View where the evaluation of the polynomial basis is stored
+    */
+    KOKKOS_INLINE_FUNCTION
+    void computeScalarTaylorJetFunctionals(const member_type& teamMember, scratch_vector_type thread_workspace, scratch_matrix_right_type P_target_row) const;
+
+    /*! \brief Returns which components of the scalar Taylor polynomial basis jet an operation needs
+        \param operation                    [in] - target operation
+        \param first_jet_component         [out] - 0 for the value, or 1+d for the partial derivative in direction d
+        \param num_jet_components          [out] - number of consecutive jet components, stored in consecutive
+                                                   output components of the operation (0 if the operation is not
+                                                   a point evaluation of the value or first partial derivatives)
+    */
+    KOKKOS_INLINE_FUNCTION
+    void getScalarTaylorJetComponents(const TargetOperation operation, int& first_jet_component, int& num_jet_components) const {
+        first_jet_component = 0;
+        num_jet_components = 0;
+        if (operation == TargetOperation::ScalarPointEvaluation || (operation == TargetOperation::VectorPointEvaluation && _dimensions == 1)) {
+            num_jet_components = 1;
+        } else if (operation == TargetOperation::GradientOfScalarPointEvaluation) {
+            first_jet_component = 1;
+            num_jet_components = _dimensions;
+        } else if (operation == TargetOperation::PartialXOfScalarPointEvaluation) {
+            first_jet_component = 1;
+            num_jet_components = 1;
+        } else if (operation == TargetOperation::PartialYOfScalarPointEvaluation && _dimensions > 1) {
+            first_jet_component = 2;
+            num_jet_components = 1;
+        } else if (operation == TargetOperation::PartialZOfScalarPointEvaluation && _dimensions > 2) {
+            first_jet_component = 3;
+            num_jet_components = 1;
+        }
+    }
+
     /*! \brief Evaluates a polynomial basis for the curvature with a gradient target functional applied
 
         _operations is used by this function which is set through a modifier function
@@ -411,8 +602,11 @@ protected:
     void computeTargetFunctionalsOnManifold(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, scratch_matrix_right_type P_target_row, scratch_matrix_right_type V, scratch_matrix_right_type G_inv, scratch_vector_type curvature_coefficients, scratch_vector_type curvature_gradients) const;
 
     //! Helper function for applying the evaluations from a target functional to the polynomial coefficients
+    //! (or, when targets are solved for first, for applying projected target functionals to P^T*W, 
+    //! given as its transpose in a scratch_matrix_left_type)
+    template <typename CoefficientsViewType>
     KOKKOS_INLINE_FUNCTION
-    void applyTargetsToCoefficients(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, scratch_matrix_right_type Q, scratch_vector_type w, scratch_matrix_right_type P_target_row, const int target_NP) const;
+    void applyTargetsToCoefficients(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, CoefficientsViewType Q, scratch_vector_type w, scratch_matrix_right_type P_target_row, const int target_NP) const;
 
 ///@}
 
@@ -436,6 +630,13 @@ protected:
         return _neighbor_lists.getNeighborDevice(target_index, neighbor_list_num);
     }
 
+    //! Returns the target index for the team at local_index in the current batch
+    KOKKOS_INLINE_FUNCTION
+    int getTargetIndexForBatch(const int local_index) const {
+        const int batch_index = _initial_index_for_batch + local_index;
+        return (_target_ordering.extent(0) > 0) ? _target_ordering(batch_index) : batch_index;
+    }
+
     //! Returns the maximum neighbor lists size over all target sites
     KOKKOS_INLINE_FUNCTION
     int getMaxNNeighbors() const {
@@ -523,6 +724,45 @@ protected:
         return coordinate_delta;
     }
 
+    //! Returns the relative coordinate as a vector between the target site and the neighbor site, read from
+    //! relative coordinates already gathered by gatherRelativeCoordinates(...)
+    KOKKOS_INLINE_FUNCTION
+    XYZ getRelativeCoord(const int neighbor_list_num, const int dimension, const scratch_matrix_right_type& relative_coordinates) const {
+        XYZ coordinate_delta;
+
+        coordinate_delta.x = relative_coordinates(neighbor_list_num, 0);
+        if (dimension>1) coordinate_delta.y = relative_coordinates(neighbor_list_num, 1);
+        if (dimension>2) coordinate_delta.z = relative_coordinates(neighbor_list_num, 2);
+
+        return coordinate_delta;
+    }
+
+    //! Gathers the coordinates of all neighbors of the team's target site relative to the target site into 
+    //! relative_coordinates (size _max_num_neighbors x 3), so that later stages read contiguous scratch rather 
+    //! than indirectly through the neighbor list. Whether global or local coordinates depends upon V being specified
+    KOKKOS_INLINE_FUNCTION
+    void gatherRelativeCoordinates(const member_type& teamMember, scratch_matrix_right_type relative_coordinates, const scratch_matrix_right_type* V = NULL) const {
+        const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember,this->getNNeighbors(target_index)),
+                [=] (const int i) {
+            Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+                const int neighbor_index = this->getNeighborIndex(target_index, i);
+                XYZ coordinate_delta;
+                for (int d=0; d<_global_dimensions; ++d) {
+                    coordinate_delta[d] = _source_coordinates(neighbor_index, d) - _target_coordinates(target_index, d);
+                }
+                for (int d=0; d<3; ++d) {
+                    if (V==NULL) {
+                        relative_coordinates(i, d) = coordinate_delta[d];
+                    } else {
+                        relative_coordinates(i, d) = (d<_dimensions) ? this->convertGlobalToLocalCoordinate(coordinate_delta, d, V) : 0;
+                    }
+                }
+            });
+        });
+        teamMember.team_barrier();
+    }
+
     //! Returns a component of the local coordinate after transformation from global to local under the orthonormal basis V.
     KOKKOS_INLINE_FUNCTION
     double convertGlobalToLocalCoordinate(const XYZ global_coord, const int dim, const scratch_matrix_right_type* V) const {
@@ -577,8 +817,11 @@ protected:
     static DenseSolverType parseSolverType(const std::string& dense_solver_type) {
         std::string solver_type_to_lower = dense_solver_type;
         transform(solver_type_to_lower.begin(), solver_type_to_lower.end(), solver_type_to_lower.begin(), ::tolower);
-        if (solver_type_to_lower == "lu") {
-            return DenseSolverType::LU;
+        if (solver_type_to_lower == "cholesky") {
+            return DenseSolverType::Cholesky;
+        } else if (solver_type_to_lower == "lu") {
+            // (deprecated) LU is an alias of Cholesky
+            return DenseSolverType::Cholesky;
         } else {
             return DenseSolverType::QR;
         }
@@ -610,6 +853,111 @@ protected:
         }
     }
 
+    //! Assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity for a standard problem
+    //! in this target's tiles of _P, _RHS, and _w.
+    //! Dimension and PolyOrder of 0 use the basis described at runtime, otherwise they select a
+    //! ScalarTaylorPolynomial basis sampled with PointSample of that dimension and order.
+    template <int Dimension, int PolyOrder>
+    KOKKOS_INLINE_FUNCTION
+    void assembleStandardPsqrtW(const member_type& teamMember) const;
+
+    //! Assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity for a standard problem
+    //! in the tiles given, which are sized as those of _P, _RHS, and _w, and are zeroed first
+    template <int Dimension, int PolyOrder>
+    KOKKOS_INLINE_FUNCTION
+    void assembleStandardPsqrtW(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace,
+            scratch_matrix_right_type PsqrtW, scratch_matrix_right_type RHS, scratch_vector_type w) const;
+
+    //! Evaluates targets and applies them to the polynomial coefficients Coeffs of a standard problem to store in _alphas
+    KOKKOS_INLINE_FUNCTION
+    void applyStandardTargets(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace,
+            scratch_matrix_right_type Coeffs, scratch_vector_type w) const;
+
+    //! Whether a specialization of assembly exists for the basis and sampling functional (see AssembleStandardPsqrtWFixedBasis)
+    bool hasFixedBasisAssembly() const;
+
+    //! Launches the AssembleStandardPsqrtW functor, or a specialization of it for the basis when one exists
+    void launchAssembleStandardPsqrtW(const int batch_size);
+
+    //! Launches AssembleStandardPsqrtWFixedBasis<Dimension,PolyOrder>
+    template <int Dimension, int PolyOrder>
+    void launchAssembleStandardPsqrtWFixedBasis(const int batch_size);
+
+    //! Launches the AssembleSolveApplyStandard functor, specialized for the basis when a specialization exists
+    void launchAssembleSolveApplyStandard(const int batch_size);
+
+    //! Launches AssembleSolveApplyStandard<Dimension,PolyOrder>
+    template <int Dimension, int PolyOrder>
+    void launchAssembleSolveApplyStandardFixedBasis(const int batch_size);
+
+    //! Team scratch (beyond that needed to assemble and apply targets) used by AssembleSolveApplyStandard
+    void getFusedStandardSolveScratchSizes(const int max_num_rows, const int this_num_cols, 
+            int& team_scratch_size_a, int& team_scratch_size_b) const;
+
+    //! Whether STANDARD problems are solved with AssembleSolveApplyStandard (see setFuseStandardSolve), 
+    //! given the scratch already needed at the lower team scratch level to assemble and apply targets
+    bool canFuseStandardSolve(const bool keep_coefficients, const int max_num_rows, const int this_num_cols, 
+            const int team_scratch_size_a) const;
+
+    //! Whether STANDARD problems solve the normal equations against their target functionals, as 
+    //! (P^T*W*P) Y = P_target_row^T, and then form alphas as Y^T*P^T*W (see setSolveTargetsFirst), rather than
+    //! solving for the polynomial coefficients and applying the target functionals to them
+    bool solvesTargetsFirst(const bool keep_coefficients, const int max_num_rows) const;
+
+    //! Size of _projected_targets needed by batches of the sizes given
+    global_index_type getProjectedTargetsStorageSize(const int this_num_cols, const std::vector<global_index_type>& batch_sizes) const;
+
+    //! Breaks target sites (or only those in target_subset, if not empty) into batches of at most 
+    //! ceil(number of targets / number_of_batches) target sites, after grouping them into number_of_buckets 
+    //! buckets by number of neighbors. host_ordering is filled with the order target sites are processed in 
+    //! if number_of_buckets > 1 or target_subset is not empty, and left empty otherwise.
+    void determineBatches(const int number_of_batches, const int number_of_buckets, const std::vector<int>& target_subset,
+            std::vector<int>& host_ordering, std::vector<global_index_type>& batch_starts, 
+            std::vector<global_index_type>& batch_sizes, std::vector<int>& batch_max_num_neighbors) const;
+
+    //! Calls generateCoefficientsForTargets once for each polynomial order set with setPolynomialOrders, on the 
+    //! target sites (or only those in target_subset, if not empty) having that order, or once if none were set
+    void generateCoefficientsForTargetsByOrder(const int number_of_batches, const bool keep_coefficients, 
+            const std::vector<int>& target_subset, const bool regenerating);
+
+    //! Implementation of generatePolynomialCoefficients. If target_subset is not empty, only those target sites
+    //! are solved for. If regenerating, their alphas are written into the existing _alphas (see regenerateAlphas).
+    void generateCoefficientsForTargets(const int number_of_batches, const bool keep_coefficients, 
+            const std::vector<int>& target_subset, const bool regenerating);
+
+    //! Copies prestencil weights and alphas to the host (unless lazy) and compresses alphas after they are generated
+    void finalizeAlphas();
+
+    //! Whether target sites with equivalent neighborhoods can share alphas (see setStencilDeduplicationTolerance)
+    bool canDeduplicateStencils(const bool keep_coefficients) const;
+
+    //! Finds target sites whose neighborhoods are translations and scalings of another target site's neighborhood.
+    //! Returns the target sites that need to be solved for (empty if all do), and fills representatives with the 
+    //! target site each target site's alphas come from, and neighbor_permutation with the order of each target
+    //! site's neighbors that is common to all target sites sharing a representative.
+    std::vector<int> findStencilRepresentatives(Kokkos::View<int*>& representatives, 
+            Kokkos::View<int*>& neighbor_permutation);
+
+    //! Copies alphas of each representative target site to the target sites it represents
+    void copyAlphasFromRepresentatives(Kokkos::View<int*> representatives, Kokkos::View<int*> neighbor_permutation);
+
+    //! Compresses _alphas into _alpha_storage_type and releases _alphas
+    void compressAlphas();
+
+    //! Returns alphas decoded into double precision from their compressed storage
+    Kokkos::View<double*, layout_right> decodeAlphas() const;
+
+    //! Sizes of _RHS, _P, and _w needed by the batch requiring the most memory
+    void getBatchStorageSizes(const int sampling_multiplier, const int this_num_cols, 
+            const std::vector<global_index_type>& batch_sizes, const std::vector<int>& batch_max_num_neighbors,
+            global_index_type& RHS_size, global_index_type& P_size, global_index_type& w_size) const;
+
+    //! Number of columns in P, size of the curvature basis (manifolds only), and scratch sizes 
+    //! needed by kernels, for a polynomial order and basis and sampling multipliers
+    void getProblemSizes(const int poly_order, const int basis_multiplier, const int sampling_multiplier, 
+            const int max_num_neighbors, int& this_num_cols, int& manifold_NP, int& team_scratch_size_a, 
+            int& team_scratch_size_b, int& thread_scratch_size_a, int& thread_scratch_size_b) const;
+
 ///@}
 
 public:
@@ -685,6 +1033,17 @@ public:
         _initial_index_for_batch = 0;
 
         _max_num_neighbors = 0;
+        _number_of_neighbor_buckets = 1;
+        _stencil_deduplication_tolerance = 0;
+        _number_of_deduplicated_targets = 0;
+        _precision_policy = PrecisionPolicy::DoublePrecision;
+        _alpha_storage_type = AlphaStorageType::DoubleAlphas;
+        _stored_alpha_type = AlphaStorageType::DoubleAlphas;
+        _pipeline_batches = false;
+        _fuse_standard_solve = false;
+        _solve_targets_first = true;
+        _lazy_host_alphas = false;
+        _host_alphas_synced = false;
         _max_evaluation_sites_per_target = 1;
 
         _global_dimensions = dimensions;
@@ -734,10 +1093,28 @@ public:
     //! Tag for functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity
     struct AssembleStandardPsqrtW{};
 
+    //! Tag for functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity
+    //! for a ScalarTaylorPolynomial basis sampled with PointSample, of dimension and order known at compile time
+    template <int Dimension, int PolyOrder>
+    struct AssembleStandardPsqrtWFixedBasis{};
+
     //! Tag for functor to evaluate targets, apply target evaluation to polynomial coefficients to
     //! store in _alphas
     struct ApplyStandardTargets{};
 
+    //! Tag for functor to assemble the P*sqrt(weights) matrix, solve it against sqrt(weights)*Identity, and
+    //! apply target evaluations to the solution to store in _alphas, all in team scratch. Dimension and 
+    //! PolyOrder select the assembly as in AssembleStandardPsqrtWFixedBasis, or the runtime basis if 0.
+    template <int Dimension, int PolyOrder>
+    struct AssembleSolveApplyStandard{};
+
+    //! Tag for functor to evaluate targets of a standard problem into _projected_targets
+    struct EvaluateStandardTargets{};
+
+    //! Tag for functor to apply targets in _projected_targets, already multiplied by (P^T*W*P)^-1, to 
+    //! P^T*W of a standard problem to store in _alphas
+    struct ApplyProjectedStandardTargets{};
+
     //! Tag for functor to create a coarse tangent approximation from a given neighborhood of points
     struct ComputeCoarseTangentPlane{};
 
@@ -768,10 +1145,31 @@ public:
     KOKKOS_INLINE_FUNCTION
     void operator() (const AssembleStandardPsqrtW&, const member_type& teamMember) const;
 
+    //! Functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity
+    //! for a ScalarTaylorPolynomial basis sampled with PointSample, of dimension and order known at compile time
+    template <int Dimension, int PolyOrder>
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const AssembleStandardPsqrtWFixedBasis<Dimension,PolyOrder>&, const member_type& teamMember) const;
+
     //! Functor to evaluate targets, apply target evaluation to polynomial coefficients to store in _alphas
     KOKKOS_INLINE_FUNCTION
     void operator() (const ApplyStandardTargets&, const member_type& teamMember) const;
 
+    //! Functor to assemble the P*sqrt(weights) matrix, solve it against sqrt(weights)*Identity, and apply 
+    //! target evaluations to the solution to store in _alphas, all in team scratch
+    template <int Dimension, int PolyOrder>
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const AssembleSolveApplyStandard<Dimension,PolyOrder>&, const member_type& teamMember) const;
+
+    //! Functor to evaluate targets of a standard problem into _projected_targets
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const EvaluateStandardTargets&, const member_type& teamMember) const;
+
+    //! Functor to apply targets in _projected_targets, already multiplied by (P^T*W*P)^-1, to P^T*W 
+    //! of a standard problem to store in _alphas
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const ApplyProjectedStandardTargets&, const member_type& teamMember) const;
+
     //! Functor to create a coarse tangent approximation from a given neighborhood of points
     KOKKOS_INLINE_FUNCTION
     void operator() (const ComputeCoarseTangentPlane&, const member_type& teamMember) const;
@@ -937,7 +1335,7 @@ public:
         compadre_assert_release(_store_PTWP_inv_PTW
                 && "generateAlphas() called with keep_coefficients set to false.");
         host_managed_local_index_type sizes("sizes", 2);
-        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::Cholesky)) {
             getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, M_by_N[1], M_by_N[0], sizes(0), sizes(1));
         } else {
             getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, M_by_N[1], M_by_N[0], sizes(1), sizes(0));
@@ -975,6 +1373,33 @@ public:
     //! Power for weighting kernel for curvature
     int getManifoldWeightingPower() const { return _curvature_weighting_power; }
 
+    //! Number of buckets target sites are grouped into by number of neighbors
+    int getNumberOfNeighborBuckets() const { return _number_of_neighbor_buckets; }
+
+    //! Tolerance used to find neighborhoods that are translations and scalings of one another (0 if not used)
+    double getStencilDeduplicationTolerance() const { return _stencil_deduplication_tolerance; }
+
+    //! Number of target sites whose alphas were copied from an equivalent target site when alphas were last generated
+    int getNumberOfDeduplicatedTargets() const { return _number_of_deduplicated_targets; }
+
+    //! Get floating point precision policy used when factoring P^T*W*P
+    PrecisionPolicy getPrecisionPolicy() const { return _precision_policy; }
+
+    //! Get storage format alphas are compressed into after generation
+    AlphaStorageType getAlphaStorageType() const { return _alpha_storage_type; }
+
+    //! Whether batches are pipelined over two sets of buffers and execution space instances
+    bool getPipelineBatches() const { return _pipeline_batches; }
+
+    //! Whether small STANDARD problems are assembled, solved, and have targets applied in a single kernel
+    bool getFuseStandardSolve() const { return _fuse_standard_solve; }
+
+    //! Whether STANDARD problems solved with LU may solve for their targets before applying them
+    bool getSolveTargetsFirst() const { return _solve_targets_first; }
+
+    //! Whether the host copy of alphas is deferred until it is first needed
+    bool getLazyHostAlphas() const { return _lazy_host_alphas; }
+
     //! Number of quadrature points
     int getNumberOfQuadraturePoints() const { return _qm.getNumberOfQuadraturePoints(); }
 
@@ -1059,16 +1484,34 @@ public:
         return getTargetOffsetIndexHost(lro_number, input_index, output_index, additional_evaluation_local_index);
     }
 
-    //! Get a view (device) of all alphas
+    //! Get a view (device) of all alphas, which is empty unless alphas are stored as DoubleAlphas
     decltype(_alphas) getAlphas() const { return _alphas; }
 
+    //! Get storage format of the alphas currently generated
+    AlphaStorageType getStoredAlphaType() const { return _stored_alpha_type; }
+
+    //! Get a view (device) of all alphas stored in single precision, which is empty unless alphas are stored as FloatAlphas
+    decltype(_float_alphas) getFloatAlphas() const { return _float_alphas; }
+
+    //! Get a view (device) of all alphas stored as 16-bit integers, which is empty unless alphas are stored as 
+    //! ScaledInt16Alphas. Each tile is multiplied by the scale from getAlphaScaleDevice or getAlphaScaleHost.
+    decltype(_int16_alphas) getInt16Alphas() const { return _int16_alphas; }
+
+    //! Scale that stored alphas in the tile beginning at getAlphaIndexHost(target_index, alpha_column_offset)
+    //! are multiplied by, which is 1 unless alphas are stored as ScaledInt16Alphas
+    double getAlphaScaleHost(const int target_index, const int alpha_column_offset) const {
+        return (_stored_alpha_type == AlphaStorageType::ScaledInt16Alphas) ?
+            _host_alpha_scales(TO_GLOBAL(target_index)*TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
+                    + TO_GLOBAL(alpha_column_offset)) : 1.0;
+    }
+
     //! Get a view (device) of all polynomial coefficients basis
     decltype(_RHS) getFullPolynomialCoefficientsBasis() const { 
         compadre_assert_release(_entire_batch_computed_at_once 
                 && "Entire batch not computed at once, so getFullPolynomialCoefficientsBasis() can not be called.");
         compadre_assert_release(_store_PTWP_inv_PTW
                 && "generateAlphas() called with keep_coefficients set to false.");
-        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::Cholesky)) {
             return _RHS; 
         } else {
             return _P; 
@@ -1150,6 +1593,15 @@ public:
 
     }
 
+    //! Scale that stored alphas in the tile beginning at getAlphaIndexDevice(target_index, alpha_column_offset)
+    //! are multiplied by, which is 1 unless alphas are stored as ScaledInt16Alphas
+    KOKKOS_INLINE_FUNCTION
+    double getAlphaScaleDevice(const int target_index, const int alpha_column_offset) const {
+        return (_stored_alpha_type == AlphaStorageType::ScaledInt16Alphas) ?
+            _alpha_scales(TO_GLOBAL(target_index)*TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
+                    + TO_GLOBAL(alpha_column_offset)) : 1.0;
+    }
+
     //! Gives index into alphas given two axes, which when incremented by the neighbor number transforms access into
     //! alphas from a rank 1 view into a rank 3 view.
     global_index_type getAlphaIndexHost(const int target_index, const int alpha_column_offset) const {
@@ -1190,10 +1642,25 @@ public:
         const int alpha_column_offset = this->getAlphaColumnOffset( lro, output_component_axis_1, 
                 output_component_axis_2, input_component_axis_1, input_component_axis_2, additional_evaluation_site);
 
+        if (!_host_alphas_synced) this->syncAlphasToHost();
+
         auto alphas_index = this->getAlphaIndexHost(target_index, alpha_column_offset);
         return _host_alphas(alphas_index + neighbor_index);
     }
 
+    //! Copies generated alphas from the device to the host, if not already copied since they were generated.
+    //! Only needs to be called explicitly when setLazyHostAlphas(true) was used and the copy should
+    //! happen at a time of the user's choosing, rather than on the first call to getAlpha.
+    void syncAlphasToHost() const {
+        if (_host_alphas_synced) return;
+        auto alphas = (_stored_alpha_type == AlphaStorageType::DoubleAlphas) ? _alphas : this->decodeAlphas();
+        auto host_alphas = Kokkos::create_mirror_view(alphas);
+        Kokkos::deep_copy(host_alphas, alphas);
+        Kokkos::fence();
+        _host_alphas = host_alphas;
+        _host_alphas_synced = true;
+    }
+
     //! Returns a stencil to transform data from its existing state into the input expected 
     //! for some sampling functionals.
     double getPreStencilWeight(SamplingFunctional sro, const int target_index, const int neighbor_index, bool for_target, const int output_component = 0, const int input_component = 0) const {
@@ -1743,6 +2210,17 @@ public:
         this->resetCoefficientData();
     }
 
+    //! (OPTIONAL) Sets basis order to be used at each target site, overriding setPolynomialOrder. Target sites
+    //! are solved in groups having the same order, each with its own basis size and scratch sizes, and alphas 
+    //! are stored in the same layout as for a single order. Only for STANDARD problems with keep_coefficients 
+    //! set to false. An empty view returns to using setPolynomialOrder for all target sites.
+    template<typename view_type>
+    void setPolynomialOrders(view_type poly_orders) {
+        _host_poly_orders = decltype(_host_poly_orders)("host polynomial orders", poly_orders.extent(0));
+        Kokkos::deep_copy(_host_poly_orders, poly_orders);
+        this->resetCoefficientData();
+    }
+
     //! Sets basis order to be used when reoncstructing curvature
     void setCurvaturePolynomialOrder(const int manifold_poly_order) {
         _curvature_poly_order = manifold_poly_order;
@@ -1761,6 +2239,89 @@ public:
         this->resetCoefficientData();
     }
 
+    //! (OPTIONAL)
+    //! Groups target sites into buckets of similar neighbor counts (equal numbers of target sites
+    //! per bucket, ordered by number of neighbors). Each bucket is assembled and solved with P, RHS,
+    //! and w tiles sized by the largest neighborhood in that bucket rather than by the largest 
+    //! neighborhood over all target sites. Default is 1 (no bucketing). Not compatible with 
+    //! keeping polynomial coefficients.
+    void setNumberOfNeighborBuckets(const int number_of_buckets) {
+        compadre_assert_release((number_of_buckets > 0) && "number_of_buckets must be greater than zero.");
+        _number_of_neighbor_buckets = number_of_buckets;
+        this->resetCoefficientData();
+    }
+
+    //! (OPTIONAL)
+    //! Target sites whose neighborhoods are the same (in any order) after subtracting the target site and
+    //! dividing by epsilon are only solved for once. Alphas of the others are copied from the one solved,
+    //! scaled by the ratio of epsilons to the power of the order of derivative of each target operation.
+    //! Coordinates relative to the target site and divided by epsilon are rounded to multiples of tolerance 
+    //! before comparison, so neighborhoods differing by less than tolerance*epsilon share alphas.
+    //! Only used for STANDARD problems with point sampling, no constraints, no additional evaluation sites,
+    //! Taylor polynomial reconstruction spaces, and when not keeping polynomial coefficients. 
+    //! Default is 0 (no deduplication).
+    void setStencilDeduplicationTolerance(const double tolerance) {
+        compadre_assert_release((tolerance == 0 || tolerance >= 1e-15) && "tolerance must be 0 or at least 1e-15.");
+        _stencil_deduplication_tolerance = tolerance;
+    }
+
+    //! Floating point precision used when factoring P^T*W*P. MixedPrecision factors in single
+    //! precision and refines in double precision, and only applies to DenseSolverType::Cholesky without constraints
+    void setPrecisionPolicy(const PrecisionPolicy precision_policy) {
+        _precision_policy = precision_policy;
+        this->resetCoefficientData();
+    }
+
+    //! (OPTIONAL)
+    //! Storage format of alphas, taking effect at the next call to generateAlphas. Alphas are always
+    //! generated in double precision, then compressed into FloatAlphas or ScaledInt16Alphas, after which
+    //! getAlphas() is empty and alphas are applied through the Evaluator or retrieved with getAlpha.
+    //! Default is DoubleAlphas.
+    void setAlphaStorageType(const AlphaStorageType alpha_storage_type) {
+        _alpha_storage_type = alpha_storage_type;
+    }
+
+    //! (OPTIONAL)
+    //! When more than one batch is used for a STANDARD problem, alternates batches between two sets
+    //! of P, RHS, and w, each with its own execution space instance, and launches every batch without
+    //! waiting on the host, so that the assembly of one batch runs while the previous batch is still being
+    //! solved and applied. Batches only overlap when ParallelManager::hasIndependentExecutionSpaces() 
+    //! (e.g. CUDA streams), and pipelining is ignored otherwise, since a second set of buffers would double
+    //! the memory used for P, RHS, and w without any overlap. Default is false.
+    void setPipelineBatches(const bool pipeline_batches) {
+        _pipeline_batches = pipeline_batches;
+    }
+
+    //! (OPTIONAL)
+    //! When true, a STANDARD problem solved with QR and NO_CONSTRAINT whose coefficients are not kept, 
+    //! with fewer columns in P than GMLS_LinearAlgebra::qr_pivoting_blocked_threshold and small enough to fit
+    //! in fused_standard_solve_max_team_scratch_bytes of team scratch, is assembled, solved, and has targets 
+    //! applied in a single kernel. P*sqrt(w), its factorization, and the polynomial coefficients are only ever
+    //! held in team scratch, so P, RHS, and w are not allocated and batches are not pipelined. 
+    //! Default is false.
+    void setFuseStandardSolve(const bool fuse_standard_solve) {
+        _fuse_standard_solve = fuse_standard_solve;
+    }
+
+    //! (OPTIONAL)
+    //! When true, a STANDARD problem solved with Cholesky and NO_CONSTRAINT whose coefficients are not kept, 
+    //! with fewer rows of target functionals (over all targets and evaluation sites) than rows in P, 
+    //! solves (P^T*W*P) Y = P_target_row^T and forms alphas as Y^T*P^T*W. This solves against one right hand 
+    //! side per target functional rather than one per neighbor, and never forms the polynomial coefficients.
+    //! Default is true.
+    void setSolveTargetsFirst(const bool solve_targets_first) {
+        _solve_targets_first = solve_targets_first;
+    }
+
+    //! (OPTIONAL)
+    //! When true, generateAlphas does not copy alphas to the host. The host copy is made on the first
+    //! call to getAlpha (or any of the getAlpha*Tensor* functions) or syncAlphasToHost after alphas are 
+    //! generated. Useful when alphas are only applied on the device, e.g. through the Evaluator. 
+    //! Default is false.
+    void setLazyHostAlphas(const bool lazy_host_alphas) {
+        _lazy_host_alphas = lazy_host_alphas;
+    }
+
     //! Number quadrature points to use
     void setOrderOfQuadraturePoints(int order) { 
         _order_of_quadrature_points = order;
@@ -1897,6 +2458,48 @@ public:
     */
     void generateAlphas(const int number_of_batches = 1, const bool keep_coefficients = false);
 
+    /*! \brief Generates alphas with the number of batches and neighbor buckets chosen by a plan
+    //! \param plan                 [in] - plan from planBatches or planBatchesUsingFreeMemory
+    */
+    void generateAlphas(const GMLSMemoryPlan& plan);
+
+    /*! \brief Regenerates alphas for only some target sites, keeping the alphas of all others
+    //! For target sites whose neighbors or coordinates changed since alphas were generated. Neighbor lists,
+    //! source sites, and target sites may be updated beforehand, but target operations and the number of target 
+    //! sites may not. If the number of neighbors of any target site changed (all of which must be listed), 
+    //! alphas of other target sites are moved to their new offsets.
+    //! \param dirty_target_indices [in] - target sites to regenerate alphas for
+    //! \param number_of_batches    [in] - how many batches to break up the dirty target sites into (for storage)
+    */
+    void regenerateAlphas(const std::vector<int>& dirty_target_indices, const int number_of_batches = 1);
+
+    //! Same as regenerateAlphas(std::vector<int>, int), with target sites given in a 1D Kokkos view (host or device)
+    template <typename view_type>
+    void regenerateAlphas(view_type dirty_target_indices, const int number_of_batches = 1) {
+        auto host_dirty_target_indices = Kokkos::create_mirror_view(dirty_target_indices);
+        Kokkos::deep_copy(host_dirty_target_indices, dirty_target_indices);
+        Kokkos::fence();
+        std::vector<int> dirty_targets(host_dirty_target_indices.extent(0));
+        for (size_t i=0; i<dirty_targets.size(); ++i) dirty_targets[i] = host_dirty_target_indices(i);
+        this->regenerateAlphas(dirty_targets, number_of_batches);
+    }
+
+    /*! \brief Chooses the number of batches (and optionally neighbor buckets) needing the fewest batches 
+    //! whose device memory fits in a budget, without allocating anything. Must be called after problem data
+    //! is set. If nothing fits, the plan with the smallest footprint is returned and fitsBudget() is false.
+    //! Assumes coefficients are not kept, so problems solved in a single kernel (see setFuseStandardSolve)
+    //! need no storage for P, RHS, or w.
+    //! \param memory_budget_in_bytes           [in] - bytes available to generateAlphas
+    //! \param max_number_of_neighbor_buckets   [in] - largest number of neighbor buckets to consider
+    */
+    GMLSMemoryPlan planBatches(const std::size_t memory_budget_in_bytes, const int max_number_of_neighbor_buckets = 1) const;
+
+    /*! \brief Same as planBatches, with a budget that is a fraction of the memory currently free on the device
+    //! \param fraction_of_free_memory          [in] - fraction in (0,1] of free device memory to use
+    //! \param max_number_of_neighbor_buckets   [in] - largest number of neighbor buckets to consider
+    */
+    GMLSMemoryPlan planBatchesUsingFreeMemory(const double fraction_of_free_memory, const int max_number_of_neighbor_buckets = 1) const;
+
 ///@}
 
 
@@ -2,12 +2,16 @@
 #define _COMPADRE_GMLS_APPLY_TARGET_EVALUATIONS_HPP_
 
 #include "Compadre_GMLS.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+
 namespace Compadre {
 
+template <typename CoefficientsViewType>
 KOKKOS_INLINE_FUNCTION
-void GMLS::applyTargetsToCoefficients(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, scratch_matrix_right_type Q, scratch_vector_type w, scratch_matrix_right_type P_target_row, const int target_NP) const {
+void GMLS::applyTargetsToCoefficients(const member_type& teamMember, scratch_vector_type t1, scratch_vector_type t2, CoefficientsViewType Q, scratch_vector_type w, scratch_matrix_right_type P_target_row, const int target_NP) const {
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 
 #if defined(COMPADRE_USE_CUDA)
 //        // GPU
@@ -97,45 +101,48 @@ void GMLS::applyTargetsToCoefficients(const member_type& teamMember, scratch_vec
 #else
 
     // CPU
-    const int alphas_per_tile_per_target = _neighbor_lists.getNumberOfNeighborsDevice(target_index) + _added_alpha_size;
+    const int num_neighbors = this->getNNeighbors(target_index);
+    const int alphas_per_tile_per_target = num_neighbors + _added_alpha_size;
     const global_index_type base_offset_index_jmke = getTargetOffsetIndexDevice(0,0,0,0);
     const global_index_type base_alphas_index = getAlphaIndexDevice(target_index, base_offset_index_jmke);
 
     scratch_matrix_right_type this_alphas(_alphas.data() + TO_GLOBAL(base_alphas_index), _total_alpha_values*_max_evaluation_sites_per_target, alphas_per_tile_per_target);
 
-    for (int e=0; e<this->getNEvaluationSitesPerTarget(target_index); ++e) {
-        // evaluating alpha_ij
-        for (size_t j=0; j<_operations.size(); ++j) {
-            for (int k=0; k<_lro_output_tile_size[j]; ++k) {
-                for (int m=0; m<_lro_input_tile_size[j]; ++m) {
-                    double alpha_ij = 0;
-                    int offset_index_jmke = getTargetOffsetIndexDevice(j,m,k,e);
-                    for (int i=0; i<this->getNNeighbors(target_index) + _added_alpha_size; ++i) {
-                        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember,
-                            _basis_multiplier*target_NP), [&] (const int l, double &talpha_ij) {
-                            if (_sampling_multiplier>1 && m<_sampling_multiplier) {
-
-                                talpha_ij += P_target_row(offset_index_jmke, l)*Q(l, i+m*this->getNNeighbors(target_index));
-
-                                compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, l)==P_target_row(offset_index_jmke, l) 
-                                        && "NaN in P_target_row matrix.");
-                                compadre_kernel_assert_extreme_debug(Q(l, i+m*this->getNNeighbors(target_index))==Q(l, i+m*this->getNNeighbors(target_index))
-                                        && "NaN in Q coefficient matrix.");
-
-                            } else if (_sampling_multiplier == 1) {
-
-                                talpha_ij += P_target_row(offset_index_jmke, l)*Q(l, i);
-
-                                compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, l)==P_target_row(offset_index_jmke, l) 
-                                        && "NaN in P_target_row matrix.");
-                                compadre_kernel_assert_extreme_debug(Q(l,i)==Q(l,i) 
-                                        && "NaN in Q coefficient matrix.");
-
-                            } else {
-                                talpha_ij += 0;
+    const int num_coefficients = _basis_multiplier*target_NP;
+
+    if (_sampling_multiplier == 1) {
+
+        // every tile of alphas (for every evaluation site) is a row of P_target_row applied to the same 
+        // coefficients, so all tiles are computed at once as this_alphas = P_target_row*Q
+        const int num_tiles = this->getNEvaluationSitesPerTarget(target_index)*_total_alpha_values;
+        auto P_tiles = Kokkos::subview(P_target_row, Kokkos::make_pair(0, num_tiles), Kokkos::make_pair(0, num_coefficients));
+        auto Q_tiles = Kokkos::subview(Q, Kokkos::make_pair(0, num_coefficients), Kokkos::make_pair(0, alphas_per_tile_per_target));
+        auto alphas_tiles = Kokkos::subview(this_alphas, Kokkos::make_pair(0, num_tiles), Kokkos::make_pair(0, alphas_per_tile_per_target));
+
+        KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::NoTranspose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
+            ::invoke(teamMember, 1.0, P_tiles, Q_tiles, 0.0, alphas_tiles);
+
+    } else {
+
+        // input component m of a tile applies to the coefficients of the m-th sampled component of each neighbor 
+        // (and is zero beyond the sampling multiplier), so each thread computes whole alphas of a tile
+        for (int e=0; e<this->getNEvaluationSitesPerTarget(target_index); ++e) {
+            for (size_t j=0; j<_operations.size(); ++j) {
+                for (int k=0; k<_lro_output_tile_size[j]; ++k) {
+                    for (int m=0; m<_lro_input_tile_size[j]; ++m) {
+                        const int offset_index_jmke = getTargetOffsetIndexDevice(j,m,k,e);
+                        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, alphas_per_tile_per_target), [&] (const int i) {
+                            double alpha_ij = 0;
+                            if (m < _sampling_multiplier) {
+                                for (int l=0; l<num_coefficients; ++l) {
+                                    alpha_ij += P_target_row(offset_index_jmke, l)*Q(l, i+m*num_neighbors);
+
+                                    compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, l)==P_target_row(offset_index_jmke, l) 
+                                            && "NaN in P_target_row matrix.");
+                                    compadre_kernel_assert_extreme_debug(Q(l, i+m*num_neighbors)==Q(l, i+m*num_neighbors)
+                                            && "NaN in Q coefficient matrix.");
+                                }
                             }
-                        }, alpha_ij);
-                        Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
                             this_alphas(offset_index_jmke,i) = alpha_ij;
                             compadre_kernel_assert_extreme_debug(alpha_ij==alpha_ij && "NaN in alphas.");
                         });
@@ -143,6 +150,7 @@ void GMLS::applyTargetsToCoefficients(const member_type& teamMember, scratch_vec
                 }
             }
         }
+
     }
 #endif
 
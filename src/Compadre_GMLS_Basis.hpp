@@ -6,7 +6,7 @@
 namespace Compadre {
 
 KOKKOS_INLINE_FUNCTION
-void GMLS::calcPij(const member_type& teamMember, double* delta, double* thread_workspace, const int target_index, int neighbor_index, const double alpha, const int dimension, const int poly_order, bool specific_order_only, const scratch_matrix_right_type* V, const ReconstructionSpace reconstruction_space, const SamplingFunctional polynomial_sampling_functional, const int additional_evaluation_local_index) const {
+void GMLS::calcPij(const member_type& teamMember, double* delta, double* thread_workspace, const int target_index, int neighbor_index, const double alpha, const int dimension, const int poly_order, bool specific_order_only, const scratch_matrix_right_type* V, const ReconstructionSpace reconstruction_space, const SamplingFunctional polynomial_sampling_functional, const int additional_evaluation_local_index, const scratch_matrix_right_type* relative_coordinates) const {
 /*
  * This class is under two levels of hierarchical parallelism, so we
  * do not put in any finer grain parallelism in this function
@@ -28,7 +28,12 @@ void GMLS::calcPij(const member_type& teamMember, double* delta, double* thread_
     }
 
     XYZ relative_coord;
-    if (neighbor_index > -1) {
+    if (neighbor_index > -1 && relative_coordinates!=NULL) {
+      // Evaluate at neighbor site, with relative coordinates already gathered into scratch
+        for (int i=0; i<dimension; ++i) {
+            relative_coord[i] = (1-alpha)*(*relative_coordinates)(neighbor_index, i);
+        }
+    } else if (neighbor_index > -1) {
       // Evaluate at neighbor site
         for (int i=0; i<dimension; ++i) {
             // calculates (alpha*target+(1-alpha)*neighbor)-1*target = (alpha-1)*target + (1-alpha)*neighbor
@@ -589,11 +594,11 @@ void GMLS::calcHessianPij(const member_type& teamMember, double* delta, double*
 
 
 KOKKOS_INLINE_FUNCTION
-void GMLS::createWeightsAndP(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p, scratch_matrix_right_type* V, const ReconstructionSpace reconstruction_space, const SamplingFunctional polynomial_sampling_functional) const {
+void GMLS::createWeightsAndP(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p, scratch_matrix_right_type* V, const ReconstructionSpace reconstruction_space, const SamplingFunctional polynomial_sampling_functional, const scratch_matrix_right_type* relative_coordinates) const {
     /*
      * Creates sqrt(W)*P
      */
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 //    printf("specific order: %d\n", specific_order);
 //    {
 //        const int storage_size = (specific_order > 0) ? this->getNP(specific_order, dimension)-this->getNP(specific_order-1, dimension) : this->getNP(_poly_order, dimension);
@@ -620,7 +625,9 @@ void GMLS::createWeightsAndP(const member_type& teamMember, scratch_vector_type
             }
 
             // get Euchlidean distance of scaled relative coordinate from the origin
-            if (V==NULL) {
+            if (relative_coordinates!=NULL) {
+                r = this->EuclideanVectorLength(this->getRelativeCoord(i, dimension, *relative_coordinates) * alpha_weight, dimension);
+            } else if (V==NULL) {
                 r = this->EuclideanVectorLength(this->getRelativeCoord(target_index, i, dimension) * alpha_weight, dimension);
             } else {
                 r = this->EuclideanVectorLength(this->getRelativeCoord(target_index, i, dimension, V) * alpha_weight, dimension);
@@ -629,7 +636,7 @@ void GMLS::createWeightsAndP(const member_type& teamMember, scratch_vector_type
             // generate weight vector from distances and window sizes
             w(i+my_num_neighbors*d) = this->Wab(r, _epsilons(target_index), _weighting_type, _weighting_power);
 
-            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i + d*my_num_neighbors, 0 /*alpha*/, dimension, polynomial_order, false /*bool on only specific order*/, V, reconstruction_space, polynomial_sampling_functional);
+            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i + d*my_num_neighbors, 0 /*alpha*/, dimension, polynomial_order, false /*bool on only specific order*/, V, reconstruction_space, polynomial_sampling_functional, 0 /*additional_evaluation_local_index*/, relative_coordinates);
 
             // storage_size needs to change based on the size of the basis
             int storage_size = this->getNP(polynomial_order, dimension, reconstruction_space);
@@ -663,15 +670,40 @@ void GMLS::createWeightsAndP(const member_type& teamMember, scratch_vector_type
 //    });
 }
 
+template <int Dimension, int PolyOrder>
+KOKKOS_INLINE_FUNCTION
+void GMLS::createWeightsAndPFixedBasis(const member_type& teamMember, scratch_matrix_right_type P, scratch_vector_type w, const scratch_matrix_right_type* relative_coordinates) const {
+    /*
+     * Creates sqrt(W)*P for ScalarTaylorPolynomial sampled with PointSample
+     */
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
+    const double cutoff_p = _epsilons(target_index);
+
+    teamMember.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember,this->getNNeighbors(target_index)),
+            [=] (const int i) {
+
+        const XYZ relative_coord = (relative_coordinates!=NULL) ? this->getRelativeCoord(i, Dimension, *relative_coordinates)
+            : this->getRelativeCoord(target_index, i, Dimension);
+
+        // generate weight vector from distances and window sizes
+        const double weight = this->Wab(this->EuclideanVectorLength(relative_coord, Dimension), cutoff_p, _weighting_type, _weighting_power);
+        w(i) = weight;
+
+        ScalarTaylorPolynomialBasis::evaluateFixedDegree<Dimension,PolyOrder>(teamMember, P.data() + i*P.extent(1), cutoff_p, relative_coord.x, relative_coord.y, relative_coord.z, std::sqrt(weight));
+    });
+    teamMember.team_barrier();
+}
+
 KOKKOS_INLINE_FUNCTION
-void GMLS::createWeightsAndPForCurvature(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, bool only_specific_order, scratch_matrix_right_type* V) const {
+void GMLS::createWeightsAndPForCurvature(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, bool only_specific_order, scratch_matrix_right_type* V, const scratch_matrix_right_type* relative_coordinates) const {
 /*
  * This function has two purposes
  * 1.) Used to calculate specifically for 1st order polynomials, from which we can reconstruct a tangent plane
  * 2.) Used to calculate a polynomial of _curvature_poly_order, which we use to calculate curvature of the manifold
  */
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 
     teamMember.team_barrier();
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember,this->getNNeighbors(target_index)),
@@ -681,7 +713,9 @@ void GMLS::createWeightsAndPForCurvature(const member_type& teamMember, scratch_
         double r;
 
         // get Euclidean distance of scaled relative coordinate from the origin
-        if (V==NULL) {
+        if (relative_coordinates!=NULL) {
+            r = this->EuclideanVectorLength(this->getRelativeCoord(i, dimension, *relative_coordinates), dimension);
+        } else if (V==NULL) {
             r = this->EuclideanVectorLength(this->getRelativeCoord(target_index, i, dimension), dimension);
         } else {
             r = this->EuclideanVectorLength(this->getRelativeCoord(target_index, i, dimension, V), dimension);
@@ -690,10 +724,10 @@ void GMLS::createWeightsAndPForCurvature(const member_type& teamMember, scratch_
         // generate weight vector from distances and window sizes
         if (only_specific_order) {
             w(i) = this->Wab(r, _epsilons(target_index), _curvature_weighting_type, _curvature_weighting_power);
-            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i, 0 /*alpha*/, dimension, 1, true /*bool on only specific order*/);
+            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i, 0 /*alpha*/, dimension, 1, true /*bool on only specific order*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, 0 /*additional_evaluation_local_index*/, relative_coordinates);
         } else {
             w(i) = this->Wab(r, _epsilons(target_index), _curvature_weighting_type, _curvature_weighting_power);
-            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i, 0 /*alpha*/, dimension, _curvature_poly_order, false /*bool on only specific order*/, V);
+            this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, i, 0 /*alpha*/, dimension, _curvature_poly_order, false /*bool on only specific order*/, V, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, 0 /*additional_evaluation_local_index*/, relative_coordinates);
         }
 
         int storage_size = only_specific_order ? this->getNP(1, dimension)-this->getNP(0, dimension) : this->getNP(_curvature_poly_order, dimension);
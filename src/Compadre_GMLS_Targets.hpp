@@ -23,7 +23,7 @@ void GMLS::computeTargetFunctionals(const member_type& teamMember, scratch_vecto
     bool additional_evaluation_sites_need_handled = 
         (_additional_evaluation_coordinates.extent(0) > 0) ? true : false; // additional evaluation sites are specified
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, P_target_row.extent(0)), [&] (const int j) {
         Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, P_target_row.extent(1)),
@@ -38,6 +38,12 @@ void GMLS::computeTargetFunctionals(const member_type& teamMember, scratch_vecto
     const int target_NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
     const int num_evaluation_sites = getNEvaluationSitesPerTarget(target_index);
 
+    if (_reconstruction_space == ReconstructionSpace::ScalarTaylorPolynomial) {
+        // values and first partial derivatives for every operation are evaluated together at each evaluation site
+        this->computeScalarTaylorJetFunctionals(teamMember, thread_workspace, P_target_row);
+        teamMember.team_barrier();
+    }
+
     for (size_t i=0; i<_operations.size(); ++i) {
 
         bool additional_evaluation_sites_handled = false; // target operations that can handle these sites should flip this flag
@@ -58,13 +64,7 @@ void GMLS::computeTargetFunctionals(const member_type& teamMember, scratch_vecto
              */
 
             if (_operations(i) == TargetOperation::ScalarPointEvaluation || (_operations(i) == TargetOperation::VectorPointEvaluation && _dimensions == 1) /* vector is a scalar in 1D */) {
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int j) {
-                    this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, -1 /* target is neighbor */, 1 /*alpha*/, _dimensions, _poly_order, false /*bool on only specific order*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, j);
-                    int offset = getTargetOffsetIndexDevice(i, 0, 0, j);
-                    for (int k=0; k<target_NP; ++k) {
-                        P_target_row(offset, k) = delta(k);
-                    }
-                });
+                // filled by computeScalarTaylorJetFunctionals
                 additional_evaluation_sites_handled = true; // additional non-target site evaluations handled
             } else if (_operations(i) == TargetOperation::LaplacianOfScalarPointEvaluation) {
                 Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
@@ -83,37 +83,17 @@ void GMLS::computeTargetFunctionals(const member_type& teamMember, scratch_vecto
                         P_target_row(offset, 2) = std::pow(_epsilons(target_index), -2);
                     }
                 });
-            } else if (_operations(i) == TargetOperation::GradientOfScalarPointEvaluation) {
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int j) {
-                    for (int d=0; d<_dimensions; ++d) {
-                        int offset = getTargetOffsetIndexDevice(i, 0, d, j);
-                        auto row = Kokkos::subview(P_target_row, offset, Kokkos::ALL());
-                        this->calcGradientPij(teamMember, row.data(), thread_workspace.data(), target_index, -1 /* target is neighbor */, 1 /*alpha*/, d /*partial_direction*/, _dimensions, _poly_order, false /*specific order only*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, j);
-                    }
-                });
-                additional_evaluation_sites_handled = true; // additional non-target site evaluations handled
-            } else if (_operations(i) == TargetOperation::PartialXOfScalarPointEvaluation) {
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int j) {
-                    int offset = getTargetOffsetIndexDevice(i, 0, 0, j);
-                    auto row = Kokkos::subview(P_target_row, offset, Kokkos::ALL());
-                    this->calcGradientPij(teamMember, row.data(), thread_workspace.data(), target_index, -1 /* target is neighbor */, 1 /*alpha*/, 0 /*partial_direction*/, _dimensions, _poly_order, false /*specific order only*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, j);
-                });
+            } else if (_operations(i) == TargetOperation::GradientOfScalarPointEvaluation
+                    || _operations(i) == TargetOperation::PartialXOfScalarPointEvaluation) {
+                // filled by computeScalarTaylorJetFunctionals
                 additional_evaluation_sites_handled = true; // additional non-target site evaluations handled
             } else if (_operations(i) == TargetOperation::PartialYOfScalarPointEvaluation) {
                 compadre_kernel_assert_release(_dimensions>1 && "PartialYOfScalarPointEvaluation requested for dim < 2");
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int j) {
-                    int offset = getTargetOffsetIndexDevice(i, 0, 0, j);
-                    auto row = Kokkos::subview(P_target_row, offset, Kokkos::ALL());
-                    this->calcGradientPij(teamMember, row.data(), thread_workspace.data(), target_index, -1 /* target is neighbor */, 1 /*alpha*/, 1 /*partial_direction*/, _dimensions, _poly_order, false /*specific order only*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, j);
-                });
+                // filled by computeScalarTaylorJetFunctionals
                 additional_evaluation_sites_handled = true; // additional non-target site evaluations handled
             } else if (_operations(i) == TargetOperation::PartialZOfScalarPointEvaluation) {
                 compadre_kernel_assert_release(_dimensions>2 && "PartialZOfScalarPointEvaluation requested for dim < 3");
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int j) {
-                    int offset = getTargetOffsetIndexDevice(i, 0, 0, j);
-                    auto row = Kokkos::subview(P_target_row, offset, Kokkos::ALL());
-                    this->calcGradientPij(teamMember, row.data(), thread_workspace.data(), target_index, -1 /* target is neighbor */, 1 /*alpha*/, 2 /*partial_direction*/, _dimensions, _poly_order, false /*specific order only*/, NULL /*&V*/, ReconstructionSpace::ScalarTaylorPolynomial, PointSample, j);
-                });
+                // filled by computeScalarTaylorJetFunctionals
                 additional_evaluation_sites_handled = true; // additional non-target site evaluations handled
             }
             // staggered gradient w/ edge integrals known analytically, using a basis
@@ -947,12 +927,56 @@ void GMLS::computeTargetFunctionals(const member_type& teamMember, scratch_vecto
     }
 }
 
+KOKKOS_INLINE_FUNCTION
+void GMLS::computeScalarTaylorJetFunctionals(const member_type& teamMember, scratch_vector_type thread_workspace, scratch_matrix_right_type P_target_row) const {
+
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
+    const int target_NP = this->getNP(_poly_order, _dimensions, ReconstructionSpace::ScalarTaylorPolynomial);
+    const int num_evaluation_sites = getNEvaluationSitesPerTarget(target_index);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_evaluation_sites), [=] (const int e) {
+        // the first operation needing a jet component has it evaluated directly into its row
+        double* jet_rows[4] = {NULL, NULL, NULL, NULL};
+        for (size_t i=0; i<_operations.size(); ++i) {
+            int first_jet_component, num_jet_components;
+            this->getScalarTaylorJetComponents(_operations(i), first_jet_component, num_jet_components);
+            for (int d=0; d<num_jet_components; ++d) {
+                if (jet_rows[first_jet_component+d] == NULL) {
+                    jet_rows[first_jet_component+d] = &P_target_row(getTargetOffsetIndexDevice(i, 0, d, e), 0);
+                }
+            }
+        }
+        if (jet_rows[0] == NULL && jet_rows[1] == NULL && jet_rows[2] == NULL && jet_rows[3] == NULL) return;
+
+        XYZ relative_coord;
+        for (int d=0; d<_dimensions; ++d) {
+            relative_coord[d] = (e > 0) ? getTargetAuxiliaryCoordinate(target_index, e, d) - getTargetCoordinate(target_index, d) : 0;
+        }
+        ScalarTaylorPolynomialBasis::evaluateJet(teamMember, jet_rows[0], jet_rows+1, NULL, thread_workspace.data(), _dimensions, _poly_order, _epsilons(target_index), relative_coord.x, relative_coord.y, relative_coord.z);
+
+        // later operations needing the same jet component copy it
+        for (size_t i=0; i<_operations.size(); ++i) {
+            int first_jet_component, num_jet_components;
+            this->getScalarTaylorJetComponents(_operations(i), first_jet_component, num_jet_components);
+            for (int d=0; d<num_jet_components; ++d) {
+                double* row = &P_target_row(getTargetOffsetIndexDevice(i, 0, d, e), 0);
+                const double* jet_row = jet_rows[first_jet_component+d];
+                if (row != jet_row) {
+                    Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, target_NP), [&] (const int k) {
+                        row[k] = jet_row[k];
+                    });
+                }
+            }
+        }
+    });
+}
+
 KOKKOS_INLINE_FUNCTION
 void GMLS::computeCurvatureFunctionals(const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P_target_row, const scratch_matrix_right_type* V, const local_index_type local_neighbor_index) const {
 
     compadre_kernel_assert_release(((int)thread_workspace.extent(0)>=(_curvature_poly_order+1)*_local_dimensions) && "Workspace thread_workspace not large enough.");
 
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, P_target_row.extent(0)), [&] (const int j) {
         Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, P_target_row.extent(1)),
@@ -966,29 +990,37 @@ void GMLS::computeCurvatureFunctionals(const member_type& teamMember, scratch_ve
 
     const int manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
     for (size_t i=0; i<_curvature_support_operations.size(); ++i) {
+        // basis evaluation is spread over the vector lanes of a thread, so a single thread of the team
+        // (with all of its vector lanes) evaluates, rather than a single lane in Kokkos::single(PerTeam)
         if (_curvature_support_operations(i) == TargetOperation::ScalarPointEvaluation) {
-            Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, 1), [&] (const int) {
                 int offset = getTargetOffsetIndexDevice(i, 0, 0, 0);
                 this->calcPij(teamMember, delta.data(), thread_workspace.data(), target_index, local_neighbor_index, 0 /*alpha*/, _dimensions-1, _curvature_poly_order, false /*bool on only specific order*/, V, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
-                for (int j=0; j<manifold_NP; ++j) {
-                    P_target_row(offset, j) = delta(j);
-                }
+                Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+                    for (int j=0; j<manifold_NP; ++j) {
+                        P_target_row(offset, j) = delta(j);
+                    }
+                });
             });
         } else if (_curvature_support_operations(i) == TargetOperation::GradientOfScalarPointEvaluation) {
-            Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, 1), [&] (const int) {
                 //int offset = i*manifold_NP;
                 int offset = getTargetOffsetIndexDevice(i, 0, 0, 0);
                 this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, local_neighbor_index, 0 /*alpha*/, 0 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, V, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
-                for (int j=0; j<manifold_NP; ++j) {
-                    P_target_row(offset, j) = delta(j);
-                }
+                Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+                    for (int j=0; j<manifold_NP; ++j) {
+                        P_target_row(offset, j) = delta(j);
+                    }
+                });
                 if (_dimensions>2) { // _dimensions-1 > 1
                     //offset = (i+1)*manifold_NP;
                     offset = getTargetOffsetIndexDevice(i, 0, 1, 0);
                     this->calcGradientPij(teamMember, delta.data(), thread_workspace.data(), target_index, local_neighbor_index, 0 /*alpha*/, 1 /*partial_direction*/, _dimensions-1, _curvature_poly_order, false /*specific order only*/, V, ReconstructionSpace::ScalarTaylorPolynomial, PointSample);
-                    for (int j=0; j<manifold_NP; ++j) {
-                        P_target_row(offset, j) = delta(j);
-                    }
+                    Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+                        for (int j=0; j<manifold_NP; ++j) {
+                            P_target_row(offset, j) = delta(j);
+                        }
+                    });
                 }
             });
         } else {
@@ -1003,7 +1035,7 @@ void GMLS::computeTargetFunctionalsOnManifold(const member_type& teamMember, scr
     compadre_kernel_assert_release(((int)thread_workspace.extent(0)>=(_poly_order+1)*_local_dimensions) && "Workspace thread_workspace not large enough.");
 
     // only designed for 2D manifold embedded in 3D space
-    const int target_index = _initial_index_for_batch + teamMember.league_rank();
+    const int target_index = this->getTargetIndexForBatch(teamMember.league_rank());
     const int target_NP = this->getNP(_poly_order, _dimensions-1, _reconstruction_space);
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, P_target_row.extent(0)), [&] (const int j) {
@@ -6,8 +6,12 @@
 #include "KokkosBatched_Gemv_Decl.hpp"
 #include "KokkosBatched_Trsv_Decl.hpp"
 #include "KokkosBatched_UTV_Decl.hpp"
+#include "KokkosBatched_UTV_TeamVector_Blocked_Impl_Compadre.hpp"
 #include "KokkosBatched_SolveUTV_Decl_Compadre.hpp"
 
+#include <algorithm>
+#include <cfloat>
+
 using namespace KokkosBatched;
 
 namespace Compadre{
@@ -22,6 +26,9 @@ namespace GMLS_LinearAlgebra {
     MatrixViewType_A _a;
     MatrixViewType_B _b;
 
+    // (OPTIONAL) flags of matrices to solve, all are solved if empty
+    Kokkos::View<int*> _matrix_flags;
+
     int _pm_getTeamScratchLevel_0;
     int _pm_getTeamScratchLevel_1;
     int _M, _N, _NRHS;
@@ -32,8 +39,9 @@ namespace GMLS_LinearAlgebra {
                       const int N,
                       const int NRHS,
                       const MatrixViewType_A &a,
-                      const MatrixViewType_B &b)
-      : _a(a), _b(b), _M(M), _N(N), _NRHS(NRHS) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
+                      const MatrixViewType_B &b,
+                      const Kokkos::View<int*> &matrix_flags = Kokkos::View<int*>())
+      : _a(a), _b(b), _matrix_flags(matrix_flags), _M(M), _N(N), _NRHS(NRHS) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
 
     template<typename MemberType>
     KOKKOS_INLINE_FUNCTION
@@ -41,8 +49,11 @@ namespace GMLS_LinearAlgebra {
 
       const int k = member.league_rank();
 
+      // matrices that are not flagged were already solved
+      if (_matrix_flags.extent(0) > 0 && _matrix_flags(k) == 0) return;
+
       // workspace vectors
-      scratch_vector_type ww_fast(member.team_scratch(_pm_getTeamScratchLevel_0), 3*_M);
+      scratch_vector_type ww_fast(member.team_scratch(_pm_getTeamScratchLevel_0), fastWorkspaceSize());
       scratch_vector_type ww_slow(member.team_scratch(_pm_getTeamScratchLevel_1), _N*_NRHS);
 
       scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
@@ -140,12 +151,32 @@ namespace GMLS_LinearAlgebra {
         }
         });
       }
-      TeamVectorSolveUTVCompadre<MemberType,AlgoTagType>
+      TeamVectorSolveUTVCompadre<MemberType,Algo::UTV::Unblocked>
         ::invoke(member, matrix_rank, _M, _N, _NRHS, uu, aa, vv, pp, bb, xx, ww_slow, ww_fast);
       member.team_barrier();
 
     }
 
+    KOKKOS_INLINE_FUNCTION
+    static int fastWorkspaceSize(const int M, const int N) {
+      // blocked factorization also stores the accumulated panel update
+      return 3*M + (std::is_same<AlgoTagType, Algo::UTV::Blocked>::value ? 
+              TeamVectorQR_WithColumnPivotingBlockedInternal_Compadre::extraWorkspaceSize(N) : 0);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    int fastWorkspaceSize() const { return fastWorkspaceSize(_M, _N); }
+
+    //! team scratch requested for each matrix at the lower (l0_scratch_size) and higher (scratch_size) levels
+    static void getScratchSizes(const int M, const int N, const int NRHS, int& l0_scratch_size, int& scratch_size) {
+      scratch_size = scratch_matrix_right_type::shmem_size(N, N); // V
+      scratch_size += scratch_matrix_right_type::shmem_size(M, N /* only N columns of U are filled, maximum */); // U
+      scratch_size += scratch_vector_type::shmem_size(N*NRHS); // W (for SolveUTV)
+
+      l0_scratch_size = scratch_vector_type::shmem_size(N); // P (temporary)
+      l0_scratch_size += scratch_vector_type::shmem_size(fastWorkspaceSize(M, N)); // W (for UTV)
+    }
+
     inline
     void run(ParallelManager pm) {
       typedef typename MatrixViewType_A::non_const_value_type value_type;
@@ -160,30 +191,461 @@ namespace GMLS_LinearAlgebra {
       _pm_getTeamScratchLevel_0 = pm.getTeamScratchLevel(0);
       _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
       
-      int scratch_size = scratch_matrix_right_type::shmem_size(_N, _N); // V
-      scratch_size += scratch_matrix_right_type::shmem_size(_M, _N /* only N columns of U are filled, maximum */); // U
-      scratch_size += scratch_vector_type::shmem_size(_N*_NRHS); // W (for SolveUTV)
+      int l0_scratch_size, scratch_size;
+      getScratchSizes(_M, _N, _NRHS, l0_scratch_size, scratch_size);
+
+      pm.clearScratchSizes();
+      pm.setTeamScratchSize(0, l0_scratch_size);
+      pm.setTeamScratchSize(1, scratch_size);
+
+      pm.CallFunctorWithTeamThreadsAndVectors(*this, _a.extent(0));
+      if (pm.getFenceBatchedSolves()) pm.getExecutionSpace().fence();
+
+      Kokkos::Profiling::popRegion();
+    }
+  };
+
+  template<typename DeviceType,
+           typename MatrixViewType_A,
+           typename MatrixViewType_B,
+           typename MatrixViewType_X>
+  struct Functor_BatchedTeamVectorCholeskySolve {
+    MatrixViewType_A _a;
+    MatrixViewType_B _b;
+
+    // flags matrices that are not numerically positive definite (left unsolved), written for every matrix
+    Kokkos::View<int*> _not_positive_definite;
+
+    // (OPTIONAL) flags of matrices to solve, all are solved if empty
+    Kokkos::View<int*> _matrix_flags;
+
+    int _pm_getTeamScratchLevel_0;
+    int _pm_getTeamScratchLevel_1;
+    int _N, _NRHS;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_BatchedTeamVectorCholeskySolve(
+                      const int N,
+                      const int NRHS,
+                      const MatrixViewType_A &a,
+                      const MatrixViewType_B &b,
+                      const Kokkos::View<int*> &not_positive_definite,
+                      const Kokkos::View<int*> &matrix_flags = Kokkos::View<int*>())
+      : _a(a), _b(b), _not_positive_definite(not_positive_definite), _matrix_flags(matrix_flags), _N(N), _NRHS(NRHS) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MemberType &member) const {
+
+      const int k = member.league_rank();
+
+      // matrices that are not flagged were already solved
+      if (_matrix_flags.extent(0) > 0 && _matrix_flags(k) == 0) {
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            _not_positive_definite(k) = 0;
+        });
+        return;
+      }
+
+      typedef Kokkos::View<double**, typename MatrixViewType_B::array_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+          b_matrix_type;
+      typedef Kokkos::View<double**, typename MatrixViewType_X::array_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+          x_matrix_type;
+
+      // workspace
+      scratch_vector_type diag(member.team_scratch(_pm_getTeamScratchLevel_0), _N);
+      scratch_matrix_right_type ww(member.team_scratch(_pm_getTeamScratchLevel_1), _NRHS, _N);
+
+      // A is symmetric, so its layout is irrelevant
+      scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
+              _a.extent(1), _a.extent(2));
+      b_matrix_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+              _b.extent(1), _b.extent(2));
+      x_matrix_type xx(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+              _b.extent(1), _b.extent(2));
+
+      // store diagonal of A, since upper triangle and diagonal are enough to restore A
+      double max_diag = 0;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member,0,_N), [&](const int i, double &t_max_diag) {
+          diag(i) = aa(i,i);
+          t_max_diag = (aa(i,i) > t_max_diag) ? aa(i,i) : t_max_diag;
+      }, Kokkos::Max<double>(max_diag));
+      member.team_barrier();
+      const double tolerance = 10.0*_N*DBL_EPSILON*max_diag;
+
+      /// A = L L^T, with L overwriting the lower triangle of A
+      bool positive_definite = true;
+      for (int j=0; j<_N; ++j) {
+        const double ajj = aa(j,j);
+        if (!(ajj > tolerance)) {
+          positive_definite = false;
+          break;
+        }
+        const double ljj = std::sqrt(ajj);
+        member.team_barrier();
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            aa(j,j) = ljj;
+        });
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member,j+1,_N),[&](const int &i) {
+            aa(i,j) /= ljj;
+        });
+        member.team_barrier();
+        // rank one update of the lower triangle of the trailing matrix
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,j+1,_N),[&](const int &i) {
+          const double lij = aa(i,j);
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,j+1,i+1),[&](const int &l) {
+              aa(i,l) -= lij*aa(l,j);
+          });
+        });
+        member.team_barrier();
+      }
+
+      if (!positive_definite) {
+        // restore lower triangle of A from its upper triangle and leave B untouched
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,i),[&](const int &l) {
+              aa(i,l) = aa(l,i);
+          });
+          Kokkos::single(Kokkos::PerThread(member), [&] () {
+              aa(i,i) = diag(i);
+          });
+        });
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            _not_positive_definite(k) = 1;
+        });
+        member.team_barrier();
+        return;
+      }
+
+      // copy B to W, since B and X share memory with possibly different layouts
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_NRHS),[&](const int &i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_N),[&](const int &j) {
+            ww(i,j) = bb(j,i);
+        });
+      });
+      member.team_barrier();
+
+      /// L L^T x = b, each right hand side is solved by a thread
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_NRHS),[&](const int &r) {
+        // L y = b
+        for (int i=0; i<_N; ++i) {
+          double sum = 0;
+          Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,0,i),[&](const int &l, double &t_sum) {
+              t_sum += aa(i,l)*ww(r,l);
+          }, sum);
+          Kokkos::single(Kokkos::PerThread(member), [&] () {
+              ww(r,i) = (ww(r,i) - sum) / aa(i,i);
+          });
+        }
+        // L^T x = y
+        for (int i=_N-1; i>=0; --i) {
+          double sum = 0;
+          Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,i+1,_N),[&](const int &l, double &t_sum) {
+              t_sum += aa(l,i)*ww(r,l);
+          }, sum);
+          Kokkos::single(Kokkos::PerThread(member), [&] () {
+              ww(r,i) = (ww(r,i) - sum) / aa(i,i);
+          });
+        }
+      });
+      member.team_barrier();
+
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_NRHS),[&](const int &j) {
+            xx(i,j) = ww(j,i);
+        });
+      });
+      Kokkos::single(Kokkos::PerTeam(member), [&] () {
+          _not_positive_definite(k) = 0;
+      });
+      member.team_barrier();
+
+    }
+
+    //! team scratch requested for each matrix at the lower (l0_scratch_size) and higher (scratch_size) levels
+    static void getScratchSizes(const int N, const int NRHS, int& l0_scratch_size, int& scratch_size) {
+      scratch_size = scratch_matrix_right_type::shmem_size(NRHS, N); // W
+      l0_scratch_size = scratch_vector_type::shmem_size(N); // diagonal of A
+    }
+
+    inline
+    void run(ParallelManager pm) {
+      Kokkos::Profiling::pushRegion("Compadre::BatchedTeamVectorCholeskySolve");
+
+      _pm_getTeamScratchLevel_0 = pm.getTeamScratchLevel(0);
+      _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
+      
+      int l0_scratch_size, scratch_size;
+      getScratchSizes(_N, _NRHS, l0_scratch_size, scratch_size);
+
+      pm.clearScratchSizes();
+      pm.setTeamScratchSize(0, l0_scratch_size);
+      pm.setTeamScratchSize(1, scratch_size);
+
+      pm.CallFunctorWithTeamThreadsAndVectors(*this, _a.extent(0));
+      if (pm.getFenceBatchedSolves()) pm.getExecutionSpace().fence();
+
+      Kokkos::Profiling::popRegion();
+    }
+  };
+
+  template<typename DeviceType,
+           typename MatrixViewType_A,
+           typename MatrixViewType_B,
+           typename MatrixViewType_X>
+  struct Functor_BatchedTeamVectorMixedPrecisionCholeskySolve {
+    MatrixViewType_A _a;
+    MatrixViewType_B _b;
+
+    // flags matrices whose single precision factorization failed or whose refinement did not converge (left unsolved),
+    // written for every matrix
+    Kokkos::View<int*> _not_refined;
+
+    int _pm_getTeamScratchLevel_0;
+    int _pm_getTeamScratchLevel_1;
+    int _N, _NRHS, _max_refinement_steps;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_BatchedTeamVectorMixedPrecisionCholeskySolve(
+                      const int N,
+                      const int NRHS,
+                      const MatrixViewType_A &a,
+                      const MatrixViewType_B &b,
+                      const Kokkos::View<int*> &not_refined,
+                      const int max_refinement_steps)
+      : _a(a), _b(b), _not_refined(not_refined), _N(N), _NRHS(NRHS), _max_refinement_steps(max_refinement_steps) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
+
+    //! max over |v(i,j)| for a (NRHS x N) scratch matrix
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    double maxAbs(const MemberType &member, const scratch_matrix_right_type &v) const {
+      double v_max = 0;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member,0,_NRHS), [&](const int r, double &t_max) {
+          double row_max = 0;
+          Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,0,_N), [&](const int i, double &tv_max) {
+              tv_max = (std::abs(v(r,i)) > tv_max) ? std::abs(v(r,i)) : tv_max;
+          }, Kokkos::Max<double>(row_max));
+          t_max = (row_max > t_max) ? row_max : t_max;
+      }, Kokkos::Max<double>(v_max));
+      return v_max;
+    }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MemberType &member) const {
+
+      const int k = member.league_rank();
+
+      typedef Kokkos::View<float**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+          float_matrix_type;
+      typedef Kokkos::View<double**, typename MatrixViewType_B::array_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+          b_matrix_type;
+      typedef Kokkos::View<double**, typename MatrixViewType_X::array_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+          x_matrix_type;
 
-      int l0_scratch_size = scratch_vector_type::shmem_size(_N); // P (temporary)
-      l0_scratch_size += scratch_vector_type::shmem_size(3*_M); // W (for UTV)
+      // workspace
+      float_matrix_type ll(member.team_scratch(_pm_getTeamScratchLevel_0), _N, _N);
+      scratch_matrix_right_type xw(member.team_scratch(_pm_getTeamScratchLevel_1), _NRHS, _N);
+      scratch_matrix_right_type rw(member.team_scratch(_pm_getTeamScratchLevel_1), _NRHS, _N);
+
+      // A is symmetric, so its layout is irrelevant, and it is only read
+      scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
+              _a.extent(1), _a.extent(2));
+      b_matrix_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+              _b.extent(1), _b.extent(2));
+      x_matrix_type xx(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+              _b.extent(1), _b.extent(2));
+
+      // copy lower triangle of A to L in single precision
+      double max_diag = 0;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member,0,_N), [&](const int i, double &t_max_diag) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,i+1),[&](const int &l) {
+              ll(i,l) = static_cast<float>(aa(i,l));
+          });
+          t_max_diag = (aa(i,i) > t_max_diag) ? aa(i,i) : t_max_diag;
+      }, Kokkos::Max<double>(max_diag));
+      member.team_barrier();
+      const float tolerance = static_cast<float>(10.0*_N*FLT_EPSILON*max_diag);
+
+      /// A = L L^T in single precision
+      bool positive_definite = (max_diag < FLT_MAX);
+      for (int j=0; j<_N && positive_definite; ++j) {
+        const float ajj = ll(j,j);
+        if (!(ajj > tolerance)) {
+          positive_definite = false;
+          break;
+        }
+        const float ljj = std::sqrt(ajj);
+        member.team_barrier();
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            ll(j,j) = ljj;
+        });
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member,j+1,_N),[&](const int &i) {
+            ll(i,j) /= ljj;
+        });
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,j+1,_N),[&](const int &i) {
+          const float lij = ll(i,j);
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,j+1,i+1),[&](const int &l) {
+              ll(i,l) -= lij*ll(l,j);
+          });
+        });
+        member.team_barrier();
+      }
+
+      if (!positive_definite) {
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            _not_refined(k) = 1;
+        });
+        member.team_barrier();
+        return;
+      }
+
+      // x = 0, r = b
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_NRHS),[&](const int &r) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_N),[&](const int &i) {
+            xw(r,i) = 0;
+            rw(r,i) = bb(i,r);
+        });
+      });
+      member.team_barrier();
+
+      // a backward stable double precision solve leaves a residual on the order of N*eps*max|A|*max|x|,
+      // where max|A| is the largest diagonal entry for a positive definite A
+      const double residual_scale = 0.5*_N*DBL_EPSILON*max_diag;
+      double residual_norm = maxAbs(member, rw);
+      bool converged = (residual_norm == 0);
+
+      // first pass is the single precision solve, the rest are refinement
+      for (int step=0; step<=_max_refinement_steps && !converged; ++step) {
+
+        /// L L^T d = r in single precision, each right hand side is solved by a thread
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_NRHS),[&](const int &r) {
+          for (int i=0; i<_N; ++i) {
+            float sum = 0;
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,0,i),[&](const int &l, float &t_sum) {
+                t_sum += ll(i,l)*static_cast<float>(rw(r,l));
+            }, sum);
+            Kokkos::single(Kokkos::PerThread(member), [&] () {
+                rw(r,i) = (static_cast<float>(rw(r,i)) - sum) / ll(i,i);
+            });
+          }
+          for (int i=_N-1; i>=0; --i) {
+            float sum = 0;
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,i+1,_N),[&](const int &l, float &t_sum) {
+                t_sum += ll(l,i)*static_cast<float>(rw(r,l));
+            }, sum);
+            Kokkos::single(Kokkos::PerThread(member), [&] () {
+                rw(r,i) = (static_cast<float>(rw(r,i)) - sum) / ll(i,i);
+            });
+          }
+          // x += d, then r = b - A x in double precision
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_N),[&](const int &i) {
+              xw(r,i) += rw(r,i);
+          });
+          for (int i=0; i<_N; ++i) {
+            double sum = 0;
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member,0,_N),[&](const int &l, double &t_sum) {
+                t_sum += aa(i,l)*xw(r,l);
+            }, sum);
+            Kokkos::single(Kokkos::PerThread(member), [&] () {
+                rw(r,i) = bb(i,r) - sum;
+            });
+          }
+        });
+        member.team_barrier();
+
+        const double previous_residual_norm = residual_norm;
+        residual_norm = maxAbs(member, rw);
+        const double solution_norm = maxAbs(member, xw);
+        converged = (residual_norm <= residual_scale*solution_norm);
+
+        // refinement has stalled (or produced NaN) when the residual does not at least halve
+        if (!converged && !(residual_norm <= 0.5*previous_residual_norm) && step > 0) break;
+      }
+
+      if (!converged) {
+        Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            _not_refined(k) = 1;
+        });
+        member.team_barrier();
+        return;
+      }
+
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_NRHS),[&](const int &j) {
+            xx(i,j) = xw(j,i);
+        });
+      });
+      Kokkos::single(Kokkos::PerTeam(member), [&] () {
+          _not_refined(k) = 0;
+      });
+      member.team_barrier();
+
+    }
+
+    //! team scratch requested for each matrix at the lower (l0_scratch_size) and higher (scratch_size) levels
+    static void getScratchSizes(const int N, const int NRHS, int& l0_scratch_size, int& scratch_size) {
+      scratch_size = 2*scratch_matrix_right_type::shmem_size(NRHS, N); // X and R
+      l0_scratch_size = Kokkos::View<float**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> >::shmem_size(N, N); // L
+    }
+
+    inline
+    void run(ParallelManager pm) {
+      Kokkos::Profiling::pushRegion("Compadre::BatchedTeamVectorMixedPrecisionCholeskySolve");
+
+      _pm_getTeamScratchLevel_0 = pm.getTeamScratchLevel(0);
+      _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
+      
+      int l0_scratch_size, scratch_size;
+      getScratchSizes(_N, _NRHS, l0_scratch_size, scratch_size);
 
       pm.clearScratchSizes();
       pm.setTeamScratchSize(0, l0_scratch_size);
       pm.setTeamScratchSize(1, scratch_size);
 
       pm.CallFunctorWithTeamThreadsAndVectors(*this, _a.extent(0));
-      Kokkos::fence();
+      if (pm.getFenceBatchedSolves()) pm.getExecutionSpace().fence();
 
       Kokkos::Profiling::popRegion();
     }
   };
 
+template <typename A_layout, typename B_layout, typename X_layout>
+void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices, const int blocked_threshold) {
+
+    typedef Kokkos::View<double***, A_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                    MatrixViewType_A;
+    typedef Kokkos::View<double***, B_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                    MatrixViewType_B;
+    typedef Kokkos::View<double***, X_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                    MatrixViewType_X;
+
+    MatrixViewType_A mat_A(A, num_matrices, lda, nda);
+    MatrixViewType_B mat_B(B, num_matrices, ldb, ndb);
+
+    if (N >= blocked_threshold) {
+        Functor_TestBatchedTeamVectorSolveUTV
+          <device_execution_space, Algo::UTV::Blocked, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(M,N,NRHS,mat_A,mat_B).run(pm);
+    } else {
+        Functor_TestBatchedTeamVectorSolveUTV
+          <device_execution_space, Algo::UTV::Unblocked, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(M,N,NRHS,mat_A,mat_B).run(pm);
+    }
 
+}
+
+template void batchQRPivotingSolve<layout_right, layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
 
 template <typename A_layout, typename B_layout, typename X_layout>
-void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices) {
+void batchCholeskySolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int N, int NRHS, const int num_matrices, const bool factor_in_single_precision, int* solve_flags) {
 
-    typedef Algo::UTV::Unblocked algo_tag_type;
     typedef Kokkos::View<double***, A_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
                     MatrixViewType_A;
     typedef Kokkos::View<double***, B_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
@@ -194,19 +656,86 @@ void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, doubl
     MatrixViewType_A mat_A(A, num_matrices, lda, nda);
     MatrixViewType_B mat_B(B, num_matrices, ldb, ndb);
 
-    Functor_TestBatchedTeamVectorSolveUTV
-      <device_execution_space, algo_tag_type, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(M,N,NRHS,mat_A,mat_B).run(pm);
+    // flags are written on device for every matrix, so the fallbacks are launched over all matrices
+    // and return early for those already solved, rather than reading the flags back to the host
+    Kokkos::View<int*> flags;
+    if (solve_flags == NULL) {
+        flags = Kokkos::View<int*>("solve flags", 2*num_matrices);
+    } else {
+        flags = Kokkos::View<int*>(solve_flags, 2*num_matrices);
+    }
+    Kokkos::View<int*> not_positive_definite = Kokkos::subview(flags, Kokkos::make_pair(0, num_matrices));
+    Kokkos::View<int*> not_refined = Kokkos::subview(flags, Kokkos::make_pair(num_matrices, 2*num_matrices));
+
+    if (factor_in_single_precision) {
+        Functor_BatchedTeamVectorMixedPrecisionCholeskySolve
+          <device_execution_space, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(N,NRHS,mat_A,mat_B,not_refined,mixed_precision_max_refinement_steps).run(pm);
+
+        // solve matrices whose refinement did not converge in double precision instead
+        Functor_BatchedTeamVectorCholeskySolve
+          <device_execution_space, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(N,NRHS,mat_A,mat_B,not_positive_definite,not_refined).run(pm);
+    } else {
+        Functor_BatchedTeamVectorCholeskySolve
+          <device_execution_space, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(N,NRHS,mat_A,mat_B,not_positive_definite).run(pm);
+    }
+
+    // solve matrices that were not numerically positive definite with QR+Pivoting instead
+    if (N >= qr_pivoting_blocked_threshold) {
+        Functor_TestBatchedTeamVectorSolveUTV
+          <device_execution_space, Algo::UTV::Blocked, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(N,N,NRHS,mat_A,mat_B,not_positive_definite).run(pm);
+    } else {
+        Functor_TestBatchedTeamVectorSolveUTV
+          <device_execution_space, Algo::UTV::Unblocked, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(N,N,NRHS,mat_A,mat_B,not_positive_definite).run(pm);
+    }
 
 }
 
-template void batchQRPivotingSolve<layout_right, layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
+template void batchCholeskySolve<layout_right, layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_right, layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_right, layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_right, layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_left , layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_left , layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_left , layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+template void batchCholeskySolve<layout_left , layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool,int*);
+
+void getBatchQRPivotingSolveScratchSizes(const int M, const int N, const int NRHS, int& scratch_size_0, int& scratch_size_1, 
+        const int blocked_threshold) {
+
+    typedef Kokkos::View<double***, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > MatrixViewType;
+
+    // layouts do not change the scratch requested
+    if (N >= blocked_threshold) {
+        Functor_TestBatchedTeamVectorSolveUTV<device_execution_space, Algo::UTV::Blocked, MatrixViewType, MatrixViewType, MatrixViewType>
+          ::getScratchSizes(M, N, NRHS, scratch_size_0, scratch_size_1);
+    } else {
+        Functor_TestBatchedTeamVectorSolveUTV<device_execution_space, Algo::UTV::Unblocked, MatrixViewType, MatrixViewType, MatrixViewType>
+          ::getScratchSizes(M, N, NRHS, scratch_size_0, scratch_size_1);
+    }
+
+}
+
+void getBatchCholeskySolveScratchSizes(const int N, const int NRHS, const bool factor_in_single_precision, 
+        int& scratch_size_0, int& scratch_size_1) {
+
+    typedef Kokkos::View<double***, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > MatrixViewType;
+
+    // each factorization is launched separately, so the largest of them is requested at any time
+    // (including the QR+Pivoting fallback for matrices that are not numerically positive definite)
+    int size_0, size_1;
+    getBatchQRPivotingSolveScratchSizes(N, N, NRHS, scratch_size_0, scratch_size_1);
+    Functor_BatchedTeamVectorCholeskySolve<device_execution_space, MatrixViewType, MatrixViewType, MatrixViewType>
+      ::getScratchSizes(N, NRHS, size_0, size_1);
+    scratch_size_0 = std::max(scratch_size_0, size_0);
+    scratch_size_1 = std::max(scratch_size_1, size_1);
+    if (factor_in_single_precision) {
+        Functor_BatchedTeamVectorMixedPrecisionCholeskySolve<device_execution_space, MatrixViewType, MatrixViewType, MatrixViewType>
+          ::getScratchSizes(N, NRHS, size_0, size_1);
+        scratch_size_0 = std::max(scratch_size_0, size_0);
+        scratch_size_1 = std::max(scratch_size_1, size_1);
+    }
+
+}
 
 } // GMLS_LinearAlgebra
 } // Compadre
@@ -18,6 +18,14 @@ namespace GMLS_LinearAlgebra {
     KOKKOS_INLINE_FUNCTION
     void largestTwoEigenvectorsThreeByThreeSymmetric(const member_type& teamMember, scratch_matrix_right_type V, scratch_matrix_right_type PtP, const int dimensions, pool_type& random_number_pool);
 
+    //! Number of columns at or above which batchQRPivotingSolve uses a blocked factorization, 
+    //! with trailing matrix updates performed a panel of columns at a time
+    const int qr_pivoting_blocked_threshold = 32;
+
+    //! Maximum number of double precision refinement steps batchCholeskySolve applies to a
+    //! solution from a single precision factorization before falling back to double precision
+    const int mixed_precision_max_refinement_steps = 2;
+
     /*! \brief Solves a batch of problems with QR+Pivoting
  
          ~ Note: Very strong assumption on B. ~
@@ -42,9 +50,93 @@ namespace GMLS_LinearAlgebra {
         \param N                    [in] - number of columns containing data in each matrix in A
         \param NRHS                 [in] - number of columns containing data in each matrix in B
         \param num_matrices         [in] - number of problems
+        \param blocked_threshold    [in] - blocked factorization is used when N is at least this
     */
     template <typename A_layout=layout_right, typename B_layout=layout_right, typename X_layout=layout_right>
-    void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices);
+    void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices, const int blocked_threshold = qr_pivoting_blocked_threshold);
+
+    //! Team scratch (in bytes) that batchQRPivotingSolve requests for each matrix at each of its two levels
+    void getBatchQRPivotingSolveScratchSizes(const int M, const int N, const int NRHS, int& scratch_size_0, int& scratch_size_1, 
+            const int blocked_threshold = qr_pivoting_blocked_threshold);
+
+    /*! \brief Solves a single problem with QR+Pivoting using all threads and vector lanes of a team
+
+         Intended to be called from within a team kernel that also assembles A and consumes the solution,
+         so that neither needs to be written to global memory. A and B take the same form as one matrix of 
+         batchQRPivotingSolve, but A must have extents of exactly (M x N). Always uses the unblocked 
+         factorization, so is intended for N less than qr_pivoting_blocked_threshold.
+
+         Workspace is taken from team scratch at scratch_level_0 and scratch_level_1, which must have at least 
+         the sizes given by getTeamQRPivotingSolveScratchSizes available after any scratch already used.
+
+        \param teamMember           [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param A                [in/out] - (M x N) matrix A (in), meaningless workspace output (out)
+        \param B                [in/out] - right hand side (in), solution (out)
+        \param M                    [in] - number of rows containing data in A
+        \param N                    [in] - number of columns containing data in A
+        \param NRHS                 [in] - number of columns containing data in B
+        \param scratch_level_0      [in] - team scratch level for small workspace vectors
+        \param scratch_level_1      [in] - team scratch level for workspace matrices
+    */
+    KOKKOS_INLINE_FUNCTION
+    void teamQRPivotingSolve(const member_type& teamMember, scratch_matrix_right_type A, scratch_matrix_right_type B, const int M, const int N, const int NRHS, const int scratch_level_0, const int scratch_level_1);
+
+    //! Team scratch (in bytes) that teamQRPivotingSolve uses at each of its two levels
+    inline void getTeamQRPivotingSolveScratchSizes(const int M, const int N, const int NRHS, int& scratch_size_0, int& scratch_size_1);
+
+    /*! \brief Forms C = A^T*A using all threads and vector lanes of a team
+
+         Only the entries of the lower triangle of C are computed (each as a dot product of two columns of A 
+         over its first M rows), and are also written to the upper triangle, so that C is the same as with 
+         a general A^T*A product for roughly half of the floating point operations.
+
+        \param teamMember           [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param C                   [out] - (N x N) symmetric matrix A^T*A
+        \param A                    [in] - matrix with at least M rows and N columns
+        \param M                    [in] - number of rows containing data in A (rows after M are treated as zero)
+        \param N                    [in] - number of columns of A, and rows and columns of C
+    */
+    KOKKOS_INLINE_FUNCTION
+    void teamSymmetricRankKUpdate(const member_type& teamMember, scratch_matrix_right_type C, scratch_matrix_right_type A, const int M, const int N);
+
+    /*! \brief Solves a batch of symmetric positive definite problems with Cholesky factorization
+
+         A contains num_matrices * lda * nda data which is num_matrices different (lda x nda) symmetric matrices with valid entries of size (N x N), and
+         B contains num_matrices * ldb * ndb data which is num_matrices different (ldb x ndb) right hand sides with valid entries of size (N x NRHS).
+
+         Only the lower triangle of each A is overwritten (by its Cholesky factor). Any matrix found to not be numerically 
+         positive definite (a pivot smaller than 10*N*machine epsilon relative to the largest diagonal entry) has its 
+         lower triangle restored and is solved instead with QR+Pivoting, as in batchQRPivotingSolve.
+
+         When factor_in_single_precision is true, each A is instead factored in single precision (in scratch, leaving A
+         untouched) and the solution is refined in double precision against A for up to 
+         mixed_precision_max_refinement_steps steps. Any matrix whose refinement stalls, or does not reach a residual 
+         comparable to that of a double precision factorization, is solved with the double precision factorization.
+
+         Which matrices need a fallback is kept on device, so no factorization is waited on by the host. Each fallback 
+         is launched over all matrices, and returns immediately for matrices that were already solved.
+
+        \param pm                   [in] - manager class for team and thread parallelism
+        \param A                [in/out] - matrix A (in), meaningless workspace output (out)
+        \param lda                  [in] - row dimension of each matrix in A
+        \param nda                  [in] - columns dimension of each matrix in A
+        \param B                [in/out] - right hand sides (in), solution (out)
+        \param ldb                  [in] - row dimension of each matrix in B
+        \param ndb                  [in] - column dimension of each matrix in B
+        \param N                    [in] - number of rows and columns containing data in each matrix in A
+        \param NRHS                 [in] - number of columns containing data in each matrix in B
+        \param num_matrices         [in] - number of problems
+        \param factor_in_single_precision [in] - factor in single precision and refine the solution in double precision
+        \param solve_flags          [in] - (OPTIONAL) device workspace of 2*num_matrices ints for the fallback flags, 
+                                          allocated (and freed, which synchronizes the device) internally if NULL
+    */
+    template <typename A_layout=layout_right, typename B_layout=layout_right, typename X_layout=layout_right>
+    void batchCholeskySolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int N, int NRHS, const int num_matrices, const bool factor_in_single_precision = false, int* solve_flags = NULL);
+
+    //! Team scratch (in bytes) that batchCholeskySolve requests for each matrix at each of its two levels
+    //! (the largest over its factorizations, including the QR+Pivoting fallback)
+    void getBatchCholeskySolveScratchSizes(const int N, const int NRHS, const bool factor_in_single_precision, 
+            int& scratch_size_0, int& scratch_size_1);
 
 } // GMLS_LinearAlgebra
 } // Compadre
@@ -3,6 +3,9 @@
 
 #include "Compadre_LinearAlgebra_Declarations.hpp"
 
+#include "KokkosBatched_UTV_Decl.hpp"
+#include "KokkosBatched_SolveUTV_Decl_Compadre.hpp"
+
 namespace Compadre {
 namespace GMLS_LinearAlgebra {
 
@@ -145,6 +148,66 @@ void largestTwoEigenvectorsThreeByThreeSymmetric(const member_type& teamMember,
 
 }
 
+KOKKOS_INLINE_FUNCTION
+void teamQRPivotingSolve(const member_type& teamMember, scratch_matrix_right_type A, scratch_matrix_right_type B, const int M, const int N, const int NRHS, const int scratch_level_0, const int scratch_level_1) {
+
+    // same workspace as each team of batchQRPivotingSolve with the unblocked factorization
+    scratch_vector_type ww_fast(teamMember.team_scratch(scratch_level_0), 3*M);
+    scratch_local_index_type pp(teamMember.team_scratch(scratch_level_0), N);
+    scratch_vector_type ww_slow(teamMember.team_scratch(scratch_level_1), N*NRHS);
+    scratch_matrix_right_type uu(teamMember.team_scratch(scratch_level_1), M, N /* only N columns of U are filled, maximum */);
+    scratch_matrix_right_type vv(teamMember.team_scratch(scratch_level_1), N, N);
+
+    /// UTV = A P^T
+    int matrix_rank(0);
+    teamMember.team_barrier();
+    KokkosBatched::TeamVectorUTV<member_type,KokkosBatched::Algo::UTV::Unblocked>
+        ::invoke(teamMember, A, pp, uu, vv, ww_fast, matrix_rank);
+    teamMember.team_barrier();
+
+    KokkosBatched::TeamVectorSolveUTVCompadre<member_type,KokkosBatched::Algo::UTV::Unblocked>
+        ::invoke(teamMember, matrix_rank, M, N, NRHS, uu, A, vv, pp, B, B, ww_slow, ww_fast);
+    teamMember.team_barrier();
+
+}
+
+void getTeamQRPivotingSolveScratchSizes(const int M, const int N, const int NRHS, int& scratch_size_0, int& scratch_size_1) {
+
+    scratch_size_0 = scratch_vector_type::shmem_size(3*M); // W (for UTV)
+    scratch_size_0 += scratch_local_index_type::shmem_size(N); // P (temporary)
+
+    scratch_size_1 = scratch_vector_type::shmem_size(N*NRHS); // W (for SolveUTV)
+    scratch_size_1 += scratch_matrix_right_type::shmem_size(M, N); // U
+    scratch_size_1 += scratch_matrix_right_type::shmem_size(N, N); // V
+
+}
+
+KOKKOS_INLINE_FUNCTION
+void teamSymmetricRankKUpdate(const member_type& teamMember, scratch_matrix_right_type C, scratch_matrix_right_type A, const int M, const int N) {
+
+    // each thread computes entries of the lower triangle, stored row by row, with vector lanes over rows of A
+    const int num_lower_entries = N*(N+1)/2;
+    teamMember.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_lower_entries), [&] (const int ij) {
+        int i = static_cast<int>((std::sqrt(8.0*ij+1.0)-1.0)/2.0);
+        // guard against roundoff in the square root
+        while (i*(i+1)/2 > ij) --i;
+        while ((i+1)*(i+2)/2 <= ij) ++i;
+        const int j = ij - i*(i+1)/2;
+
+        double c_ij = 0;
+        Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, M), [&] (const int k, double& t_c_ij) {
+            t_c_ij += A(k,i)*A(k,j);
+        }, c_ij);
+        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+            C(i,j) = c_ij;
+            C(j,i) = c_ij;
+        });
+    });
+    teamMember.team_barrier();
+
+}
+
 } // GMLS_LinearAlgebra
 } // Compadre
 
@@ -157,7 +157,7 @@ void getRHSDims(DenseSolverType dense_solver_type, ConstraintType constraint_typ
     if (constraint_type == NEUMANN_GRAD_SCALAR) {
         RHS_row = RHS_col = N + added_coeff_size;
     } else {
-        if (dense_solver_type != LU) {
+        if (dense_solver_type != Cholesky) {
             RHS_row = N;
             RHS_col = M;
         } else {
@@ -179,7 +179,7 @@ void getPDims(DenseSolverType dense_solver_type, ConstraintType constraint_type,
         out_row = M + added_alpha_size;
         out_col = N + added_coeff_size;
     } else {
-        if (dense_solver_type == LU) {
+        if (dense_solver_type == Cholesky) {
             out_row = M + added_alpha_size;
             out_col = N + added_coeff_size;
         } else {
@@ -67,6 +67,27 @@ namespace Compadre {
         0, ///< ScalarFaceAverageEvaluation
     };
 
+    //! Order of the derivatives taken by each TargetOperation, so that alphas for a neighborhood scaled 
+    //! by a factor of s (along with its epsilon) are scaled by a factor of s^(-order).
+    //! -1 if alphas do not scale this way.
+    constexpr int TargetOperationDerivativeOrder[] {
+        0, ///< PointEvaluation
+        0, ///< VectorPointEvaluation
+        2, ///< LaplacianOfScalarPointEvaluation
+        2, ///< VectorLaplacianPointEvaluation
+        1, ///< GradientOfScalarPointEvaluation
+        1, ///< GradientOfVectorPointEvaluation
+        1, ///< DivergenceOfVectorPointEvaluation
+        1, ///< CurlOfVectorPointEvaluation
+        2, ///< CurlCurlOfVectorPointEvaluation
+        1, ///< PartialXOfScalarPointEvaluation
+        1, ///< PartialYOfScalarPointEvaluation
+        1, ///< PartialZOfScalarPointEvaluation
+        -1, ///< ChainedStaggeredLaplacianOfScalarPointEvaluation
+        -1, ///< GaussianCurvaturePointEvaluation
+        -1, ///< ScalarFaceAverageEvaluation
+    };
+
     //! Space in which to reconstruct polynomial
     enum ReconstructionSpace {
         //! Scalar polynomial basis centered at the target site and scaled by sum of basis powers 
@@ -175,8 +196,33 @@ namespace Compadre {
     enum DenseSolverType {
         //! QR+Pivoting factorization performed on P*sqrt(w) matrix
         QR, 
-        //! LU factorization performed on P^T*W*P matrix
-        LU, 
+        //! Cholesky factorization performed on P^T*W*P matrix, with QR+Pivoting performed on P^T*W*P
+        //! instead when it is not numerically positive definite or constraints make it indefinite
+        Cholesky, 
+        //! (DEPRECATED) The LU factorization of P^T*W*P was replaced by Cholesky, which LU is now an alias of
+        LU = Cholesky, 
+    };
+
+    //! Floating point precision policy for solving GMLS problems
+    enum PrecisionPolicy {
+        //! Assemble, factor, and solve in double precision
+        DoublePrecision,
+        //! Factor P^T*W*P in single precision and refine the solution in double precision,
+        //! falling back to double precision for any problem where refinement stalls.
+        //! Only affects DenseSolverType::Cholesky without constraints, which is otherwise solved in double precision.
+        MixedPrecision,
+    };
+
+    //! Storage format of generated alphas
+    enum AlphaStorageType {
+        //! Alphas stored in double precision
+        DoubleAlphas,
+        //! Alphas stored in single precision
+        FloatAlphas,
+        //! Alphas stored as 16-bit integers, with a double precision scale for each tile of alphas 
+        //! (one target site and one alpha column offset). Each alpha is accurate to about 1.5e-5
+        //! times the largest alpha in magnitude in its tile.
+        ScaledInt16Alphas,
     };
 
     //! Problem type, that optionally can handle manifolds
@@ -41,6 +41,12 @@ protected:
     int _default_threads;
     int _default_vector_lanes;
 
+    //! execution space instance that all kernels are launched on
+    device_execution_space _space;
+
+    //! whether batched solvers fence the execution space instance after their kernels
+    bool _fence_batched_solves;
+
 
 /** @name Private Modifiers
  *  Private function because information lives on the device
@@ -68,7 +74,7 @@ public:
 ///@{
 
     ParallelManager() : _team_scratch_size_a(0), _thread_scratch_size_a(0), 
-            _team_scratch_size_b(0), _thread_scratch_size_b(0) {
+            _team_scratch_size_b(0), _thread_scratch_size_b(0), _fence_batched_solves(true) {
 
 #ifdef COMPADRE_USE_CUDA
         _scratch_team_level_a = 0;
@@ -112,14 +118,14 @@ public:
     //! Calls a parallel_for
     //! parallel_for will break out over loops over teams with each vector lane executing code be default
     template<typename Tag, class C>
-    void CallFunctorWithTeamThreadsAndVectors(C functor, const global_index_type batch_size, const int threads_per_team = -1, 
+    void CallFunctorWithTeamThreadsAndVectors(const C& functor, const global_index_type batch_size, const int threads_per_team = -1, 
             const int vector_lanes_per_thread = -1) const {
 
         if (threads_per_team>0 && vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -128,7 +134,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -136,7 +142,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -144,7 +150,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -153,7 +159,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -162,7 +168,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -170,7 +176,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -178,7 +184,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -187,7 +193,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -196,7 +202,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -204,7 +210,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -212,7 +218,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -221,7 +227,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -230,7 +236,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -238,7 +244,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -246,7 +252,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -257,14 +263,14 @@ public:
     //! Calls a parallel_for
     //! parallel_for will break out over loops over teams with each vector lane executing code be default
     template<class C>
-    void CallFunctorWithTeamThreadsAndVectors(C functor, const global_index_type batch_size, const int threads_per_team = -1, 
+    void CallFunctorWithTeamThreadsAndVectors(const C& functor, const global_index_type batch_size, const int threads_per_team = -1, 
             const int vector_lanes_per_thread = -1, std::string functor_name = typeid(C).name()) const {
 
         if (threads_per_team>0 && vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -273,7 +279,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -281,7 +287,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -289,7 +295,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -298,7 +304,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -307,7 +313,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -315,7 +321,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -323,7 +329,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -331,7 +337,7 @@ public:
         } else if (vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -340,7 +346,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -348,7 +354,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -356,7 +362,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -364,7 +370,7 @@ public:
         } else {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -373,7 +379,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -381,7 +387,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -389,7 +395,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -400,7 +406,7 @@ public:
     //! Calls a parallel_for
     //! parallel_for will break out over loops over teams with each thread executing code be default
     template<typename Tag, class C>
-    void CallFunctorWithTeamThreads(C functor, const global_index_type batch_size) const {
+    void CallFunctorWithTeamThreads(const C& functor, const global_index_type batch_size) const {
         // calls breakout over vector lanes with vector lane size of 1
         CallFunctorWithTeamThreadsAndVectors<Tag,C>(functor, batch_size, _default_threads, 1);
     }
@@ -408,11 +414,41 @@ public:
     //! Calls a parallel_for
     //! parallel_for will break out over loops over teams with each thread executing code be default
     template<class C>
-    void CallFunctorWithTeamThreads(C functor, const global_index_type batch_size, std::string functor_name = typeid(C).name()) const {
+    void CallFunctorWithTeamThreads(const C& functor, const global_index_type batch_size, std::string functor_name = typeid(C).name()) const {
         // calls breakout over vector lanes with vector lane size of 1
         CallFunctorWithTeamThreadsAndVectors<C>(functor, batch_size, _default_threads, 1, functor_name);
     }
 
+    //! Number of threads per team used when not specified at launch
+    int getDefaultThreads() const {
+        return _default_threads;
+    }
+
+    //! Number of vector lanes per thread used when not specified at launch
+    int getDefaultVectorLanes() const {
+        return _default_vector_lanes;
+    }
+
+    //! Execution space instance that all kernels are launched on
+    const device_execution_space& getExecutionSpace() const {
+        return _space;
+    }
+
+    //! Whether kernels launched on distinct execution space instances of the device can execute concurrently
+    //! (CUDA streams can, while other backends execute every instance in order on the same resources)
+    static bool hasIndependentExecutionSpaces() {
+#ifdef COMPADRE_USE_CUDA
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    //! Whether batched solvers fence the execution space instance after their kernels
+    bool getFenceBatchedSolves() const {
+        return _fence_batched_solves;
+    }
+
     KOKKOS_INLINE_FUNCTION
     int getTeamScratchLevel(const int level) const {
         if (level == 0) {
@@ -489,6 +525,18 @@ public:
         }
     }
 
+    //! Launches all subsequent kernels on the execution space instance given (e.g. a Kokkos::Cuda
+    //! instance built on a user's stream), so that work from independent managers may overlap
+    void setExecutionSpace(const device_execution_space& space) {
+        _space = space;
+    }
+
+    //! When false, batched solvers return without fencing the execution space instance after their kernels,
+    //! leaving later kernels launched on the same instance to be ordered after them (default is true)
+    void setFenceBatchedSolves(const bool fence_batched_solves) {
+        _fence_batched_solves = fence_batched_solves;
+    }
+
     void clearScratchSizes() {
         _team_scratch_size_a = 0;
         _team_scratch_size_b = 0;
@@ -29,6 +29,60 @@ namespace DivergenceFreePolynomialBasis {
                        + ScalarTaylorPolynomialBasis::getSize(degree, dimension-1);
     }
 
+    /*! \brief Evaluates a partial derivative (of order 0, 1, or 2) of the divergence-free polynomial basis
+     *  delta[j] = weight_of_original_value * delta[j] + weight_of_new_value * (calculation of this function)
+
+        Each block of the basis (one per spatial dimension) is a scalar Taylor polynomial basis, zero, or the
+        negated integral of a partial derivative of a scalar Taylor polynomial basis function, so every entry
+        is a signed product of (x/h)^k/k! table entries. Entries of each block are distributed over the vector
+        lanes of the calling thread.
+
+        \param partial_direction_1      [in] - direction of first partial derivative, or -1 for none
+        \param partial_direction_2      [in] - direction of second partial derivative, or -1 for none
+    */
+    KOKKOS_INLINE_FUNCTION
+    void evaluateBlocks(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int component, const int partial_direction_1, const int partial_direction_2, const double h, const double x, const double y, const double z, const int starting_order, const double weight_of_original_value, const double weight_of_new_value) {
+        compadre_kernel_assert_release((dimension==2 || dimension==3) && "Divergence-free basis only defined or dimensions 2 and 3.");
+        ScalarTaylorPolynomialBasis::evaluateScaledPowers(teamMember, workspace, dimension, max_degree, h, x, y, z);
+        double scaling = 1.0;
+        if (partial_direction_1 >= 0) scaling /= h;
+        if (partial_direction_2 >= 0) scaling /= h;
+        int i = 0;
+        for (int d=0; d<dimension; ++d) {
+            // the last block uses a scalar basis of one dimension lower
+            const int block_dimension = ((d+1)==dimension) ? dimension-1 : dimension;
+            const int block_size = ScalarTaylorPolynomialBasis::getSize(max_degree, block_dimension);
+            const bool zero_block = (component!=d) && (((d+1)==dimension) || (dimension==3 && component==(d+1)%3));
+            const bool integrated_block = (component!=d) && !zero_block;
+            const int offset = (zero_block || starting_order==0) ? 0 : ScalarTaylorPolynomialBasis::getSize(starting_order-1, block_dimension);
+            const int count = block_size - offset;
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, count), [&] (const int j) {
+                double value = 0.0;
+                if (!zero_block) {
+                    int var_pow[3];
+                    ScalarTaylorPolynomialBasis::getMultiIndex(block_dimension, offset+j, var_pow[0], var_pow[1], var_pow[2]);
+                    bool nonzero = true;
+                    if (integrated_block) {
+                        // -\int \frac{\partial}{\partial d}(b_i) d(component)
+                        var_pow[d]--;
+                        nonzero = (var_pow[d] >= 0);
+                        var_pow[component]++;
+                    }
+                    if (partial_direction_1 >= 0) var_pow[partial_direction_1]--;
+                    if (partial_direction_2 >= 0) var_pow[partial_direction_2]--;
+                    if (nonzero && var_pow[0]>=0 && var_pow[1]>=0 && var_pow[2]>=0) {
+                        value = (integrated_block) ? -scaling : scaling;
+                        for (int k=0; k<dimension; ++k) {
+                            value *= workspace[k*(max_degree+1) + var_pow[k]];
+                        }
+                    }
+                }
+                *(delta+i+j) = ((weight_of_original_value == 0) ? 0 : weight_of_original_value * *(delta+i+j)) + weight_of_new_value * value;
+            });
+            i += count;
+        }
+    }
+
     /*! \brief Evaluates the divergence-free polynomial basis
      *  delta[j] = weight_of_original_value * delta[j] + weight_of_new_value * (calculation of this function)
         \param delta                [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large as the _basis_multipler*the dimension of the polynomial basis.
@@ -45,159 +99,7 @@ namespace DivergenceFreePolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluate(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int component, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
-        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 2D scalar basis definition
-                            // (in 2D) \sum_{n=0}^{n=P} \sum_{k=0}^{k=n} (x/h)^(n-k)*(y/h)^k / ((n-k)!k!)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-                                    alphaf = factorial[alphax]*factorial[alphay];
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[alphax]*y_over_h_to_i[alphay]/alphaf;
-                                    i++;
-                                }
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 3D scalar basis definition
-                            // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-                                        alphaf = factorial[alphax]*factorial[alphay]*factorial[alphaz];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[alphax]*y_over_h_to_i[alphay]*z_over_h_to_i[alphaz]/alphaf;
-                                        i++;
-                                    }
-                                }
-                            }
-                        } else if (component==(d+1)%3) {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        } else {
-                            // (in 3D)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-
-                                        int var_pow[3] = {(d == 0) ? alphax-1 : alphax, (d == 1) ? alphay-1 : alphay, (d == 2) ? alphaz-1 : alphaz};
-
-                                        if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            var_pow[component]++;
-                                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1 * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                                        }
-                                        i++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 1D scalar basis definition
-                            // (in 1D) \sum_{n=0}^{n=P} (x/h)^n / n!
-                            for (int j=starting_order; j<=max_degree; ++j) {
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[j]/factorial[j];
-                                i++;
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 2D scalar basis definition
-                            // (in 2D) \sum_{n=0}^{n=P} \sum_{k=0}^{k=n} (x/h)^(n-k)*(y/h)^k / ((n-k)!k!)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-                                    alphaf = factorial[alphax]*factorial[alphay];
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[alphax]*y_over_h_to_i[alphay]/alphaf;
-                                    i++;
-                                }
-                            }
-                        } else {
-                            // (in 2D)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[2] = {(d == 0) ? alphax-1 : alphax, (d == 1) ? alphay-1 : alphay};
-
-                                    if (var_pow[0]<0 || var_pow[1]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        var_pow[component]++;
-                                        alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1 * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                    }
-                                    i++;
-                                }
-                            }
-                        }
-                    }
-                }
-
-            } else {
-                compadre_kernel_assert_release((false) && "Divergence-free basis only defined or dimensions 2 and 3.");
-            }
-        });
+        evaluateBlocks(teamMember, delta, workspace, dimension, max_degree, component, -1, -1, h, x, y, z, starting_order, weight_of_original_value, weight_of_new_value);
     }
 
     /*! \brief Evaluates the first partial derivatives of the divergence-free polynomial basis
@@ -217,205 +119,7 @@ namespace DivergenceFreePolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluatePartialDerivative(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int component, const int partial_direction, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
-        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 2D partial derivative of scalar basis definition
-                            // (in 2D) \sum_{n=0}^{n=P} \sum_{k=0}^{k=n} (x/h)^(n-k)*(y/h)^k / ((n-k)!k!)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[3] = {alphax, alphay, 0};
-                                    var_pow[partial_direction]--;
-                
-                                    if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                    }
-                                    i++;
-                                }
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 3D partial derivative of scalar basis definition
-                            // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-
-                                        int var_pow[3] = {alphax, alphay, alphaz};
-                                        var_pow[partial_direction]--;
-                
-                                        if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                                        }
-                                        i++;
-                                    }
-                                }
-                            }
-                        } else if (component==(d+1)%3) {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        } else {
-                            // (in 3D)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-
-                                        int var_pow[3] = {alphax, alphay, alphaz};
-                                        var_pow[d]--;
-
-                                        if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            var_pow[component]++;
-                                            var_pow[partial_direction]--;
-                                            if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                            } else {
-                                                alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1.0/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                                            }
-                                        }
-                                        i++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 1D partial derivative of scalar basis definition
-                            int alphax;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                alphax = n;
-                            
-                                int var_pow[2] = {alphax, 0};
-                                var_pow[partial_direction]--;
-
-                                if (var_pow[0]<0 || var_pow[1]<0) {
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                } else {
-                                    alphaf = factorial[var_pow[0]];
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]/alphaf;
-                                }
-                                i++;
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 2D partial derivative of scalar basis definition
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[2] = {alphax, alphay};
-                                    var_pow[partial_direction]--;
-
-                                    if (var_pow[0]<0 || var_pow[1]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                    }
-                                    i++;
-                                }
-                            }
-                        } else {
-                            // (in 2D)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[2] = {alphax, alphay};
-                                    var_pow[d]--;
-
-                                    if (var_pow[0]<0 || var_pow[1]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        var_pow[component]++;
-                                        var_pow[partial_direction]--;
-                                        if (var_pow[0]<0 || var_pow[1]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1.0/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                        }
-                                    }
-                                    i++;
-                                }
-                            }
-                        }
-                    }
-                }
-
-            } else {
-                compadre_kernel_assert_release((false) && "Divergence-free basis only defined or dimensions 2 and 3.");
-            }
-        });
+        evaluateBlocks(teamMember, delta, workspace, dimension, max_degree, component, partial_direction, -1, h, x, y, z, starting_order, weight_of_original_value, weight_of_new_value);
     }
 
     /*! \brief Evaluates the second partial derivatives of the divergence-free polynomial basis
@@ -436,211 +140,7 @@ namespace DivergenceFreePolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluateSecondPartialDerivative(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int component, const int partial_direction_1, const int partial_direction_2, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
-        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 2D partial derivative of scalar basis definition
-                            // (in 2D) \sum_{n=0}^{n=P} \sum_{k=0}^{k=n} (x/h)^(n-k)*(y/h)^k / ((n-k)!k!)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[3] = {alphax, alphay, 0};
-                                    var_pow[partial_direction_1]--;
-                                    var_pow[partial_direction_2]--;
-                
-                                    if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                    }
-                                    i++;
-                                }
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 3D partial derivative of scalar basis definition
-                            // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-
-                                        int var_pow[3] = {alphax, alphay, alphaz};
-                                        var_pow[partial_direction_1]--;
-                                        var_pow[partial_direction_2]--;
-                
-                                        if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                                        }
-                                        i++;
-                                    }
-                                }
-                            }
-                        } else if (component==(d+1)%3) {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        } else {
-                            // (in 3D)
-                            int alphax, alphay, alphaz;
-                            double alphaf;
-                            int s=0;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphaz = 0; alphaz <= n; alphaz++){
-                                    s = n - alphaz;
-                                    for (alphay = 0; alphay <= s; alphay++){
-                                        alphax = s - alphay;
-
-                                        int var_pow[3] = {alphax, alphay, alphaz};
-                                        var_pow[d]--;
-
-                                        if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            var_pow[component]++;
-                                            var_pow[partial_direction_1]--;
-                                            var_pow[partial_direction_2]--;
-                                            if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                            } else {
-                                                alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1.0/h/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                                            }
-                                        }
-                                        i++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                int i=0;
-                for (int d=0; d<dimension; ++d) {
-                    if ((d+1)==dimension) {
-                        if (component==d) {
-                            // use 1D partial derivative of scalar basis definition
-                            int alphax;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                alphax = n;
-                            
-                                int var_pow[2] = {alphax, 0};
-                                var_pow[partial_direction_1]--;
-                                var_pow[partial_direction_2]--;
-
-                                if (var_pow[0]<0 || var_pow[1]<0) {
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                } else {
-                                    alphaf = factorial[var_pow[0]];
-                                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h/h * x_over_h_to_i[var_pow[0]]/alphaf;
-                                }
-                                i++;
-                            }
-                        } else {
-                            for (int j=0; j<ScalarTaylorPolynomialBasis::getSize(max_degree, dimension-1); ++j) { 
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0;
-                                i++;
-                            }
-                        }
-                    } else {
-                        if (component==d) {
-                            // use 2D partial derivative of scalar basis definition
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[2] = {alphax, alphay};
-                                    var_pow[partial_direction_1]--;
-                                    var_pow[partial_direction_2]--;
-
-                                    if (var_pow[0]<0 || var_pow[1]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                    }
-                                    i++;
-                                }
-                            }
-                        } else {
-                            // (in 2D)
-                            int alphax, alphay;
-                            double alphaf;
-                            for (int n = starting_order; n <= max_degree; n++){
-                                for (alphay = 0; alphay <= n; alphay++){
-                                    alphax = n - alphay;
-
-                                    int var_pow[2] = {alphax, alphay};
-                                    var_pow[d]--;
-
-                                    if (var_pow[0]<0 || var_pow[1]<0) {
-                                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                    } else {
-                                        var_pow[component]++;
-                                        var_pow[partial_direction_1]--;
-                                        var_pow[partial_direction_2]--;
-                                        if (var_pow[0]<0 || var_pow[1]<0) {
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                                        } else {
-                                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * -1.0/h/h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                                        }
-                                    }
-                                    i++;
-                                }
-                            }
-                        }
-                    }
-                }
-
-            } else {
-                compadre_kernel_assert_release((false) && "Divergence-free basis only defined or dimensions 2 and 3.");
-            }
-        });
+        evaluateBlocks(teamMember, delta, workspace, dimension, max_degree, component, partial_direction_1, partial_direction_2, h, x, y, z, starting_order, weight_of_original_value, weight_of_new_value);
     }
 
     /*! \brief Evaluates the hard-coded divergence-free polynomial basis up to order 4 for 3D
@@ -24,6 +24,96 @@ namespace ScalarTaylorPolynomialBasis {
         else return degree+1;
     }
 
+    /*! \brief Returns the exponents of x, y, and z for a basis function
+        
+        Basis functions are ordered by degree n, then by the exponent of z, then by the exponent of y,
+        matching the order produced by evaluate(...). Exponents of directions beyond the dimension are 0.
+
+        \param dimension            [in] - spatial dimension of the basis
+        \param index                [in] - index of the basis function
+        \param alphax              [out] - exponent of x
+        \param alphay              [out] - exponent of y
+        \param alphaz              [out] - exponent of z
+    */
+    KOKKOS_INLINE_FUNCTION
+    void getMultiIndex(const int dimension, const int index, int& alphax, int& alphay, int& alphaz) {
+        alphax = index;
+        alphay = 0;
+        alphaz = 0;
+        if (dimension==1) return;
+        // degree of the basis function, and its position among basis functions of that degree
+        int n = 0;
+        while (getSize(n, dimension) <= index) n++;
+        int r = (n > 0) ? index - getSize(n-1, dimension) : index;
+        if (dimension==3) {
+            // each exponent of z is followed by n-alphaz+1 exponents of y
+            while (r > n-alphaz) {
+                r -= n-alphaz+1;
+                alphaz++;
+            }
+        }
+        alphay = r;
+        alphax = n - alphaz - alphay;
+    }
+
+    /*! \brief Fills workspace with (x/h)^k/k!, (y/h)^k/k!, and (z/h)^k/k! for k=0..max_degree
+
+        Forming each power and its inverse factorial once per direction leaves a single product of
+        table entries for each basis function, which the vector lanes of a thread then read in parallel.
+
+        \param workspace           [out] - scratch space of at least (max_degree+1)*dimension, holding
+                                           the powers of direction d starting at workspace+d*(max_degree+1)
+        \param dimension            [in] - spatial dimension to evaluate
+        \param max_degree           [in] - highest degree of polynomial
+        \param h                    [in] - epsilon/window size
+        \param x                    [in] - x coordinate (already shifted by target)
+        \param y                    [in] - y coordinate (already shifted by target)
+        \param z                    [in] - z coordinate (already shifted by target)
+    */
+    KOKKOS_INLINE_FUNCTION
+    void evaluateScaledPowers(const member_type& teamMember, double* workspace, const int dimension, const int max_degree, const double h, const double x, const double y, const double z) {
+        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+            const double coordinate[3] = {x, y, z};
+            for (int d=0; d<dimension; ++d) {
+                double* scaled_powers = workspace + d*(max_degree+1);
+                scaled_powers[0] = 1;
+                for (int k=1; k<=max_degree; ++k) {
+                    scaled_powers[k] = scaled_powers[k-1]*(coordinate[d]/h)/k;
+                }
+            }
+        });
+    }
+
+    /*! \brief Evaluates a partial derivative (of order 0, 1, or 2) of each basis function from starting_order to max_degree
+     *  delta[j] = weight_of_original_value * delta[j] + weight_of_new_value * scaling * (calculation of this function)
+
+        Requires workspace to be filled by evaluateScaledPowers(...). Basis functions are distributed over
+        the vector lanes of the calling thread.
+
+        \param partial_direction_1      [in] - direction of first partial derivative, or -1 for none
+        \param partial_direction_2      [in] - direction of second partial derivative, or -1 for none
+        \param scaling                  [in] - factor applied to every basis function (e.g. powers of 1/h from derivatives)
+    */
+    KOKKOS_INLINE_FUNCTION
+    void evaluateFromScaledPowers(const member_type& teamMember, double* delta, const double* workspace, const int dimension, const int max_degree, const int partial_direction_1, const int partial_direction_2, const double scaling, const int starting_order, const double weight_of_original_value, const double weight_of_new_value) {
+        const int offset = (starting_order > 0) ? getSize(starting_order-1, dimension) : 0;
+        const int count = getSize(max_degree, dimension) - offset;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, count), [&] (const int i) {
+            int var_pow[3];
+            getMultiIndex(dimension, offset+i, var_pow[0], var_pow[1], var_pow[2]);
+            if (partial_direction_1 >= 0) var_pow[partial_direction_1]--;
+            if (partial_direction_2 >= 0) var_pow[partial_direction_2]--;
+            double value = 0.0;
+            if (var_pow[0]>=0 && var_pow[1]>=0 && var_pow[2]>=0) {
+                value = scaling;
+                for (int d=0; d<dimension; ++d) {
+                    value *= workspace[d*(max_degree+1) + var_pow[d]];
+                }
+            }
+            *(delta+i) = ((weight_of_original_value == 0) ? 0 : weight_of_original_value * *(delta+i)) + weight_of_new_value * value;
+        });
+    }
+
     /*! \brief Evaluates the scalar Taylor polynomial basis
      *  delta[j] = weight_of_original_value * delta[j] + weight_of_new_value * (calculation of this function)
         \param delta                [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large as the _basis_multipler*the dimension of the polynomial basis.
@@ -40,65 +130,65 @@ namespace ScalarTaylorPolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluate(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
+        evaluateScaledPowers(teamMember, workspace, dimension, max_degree, h, x, y, z);
+        // in 1D, each basis function is stored at the index of its degree, even when starting_order > 0
+        double* first_delta = (dimension==1) ? delta+starting_order : delta;
+        evaluateFromScaledPowers(teamMember, first_delta, workspace, dimension, max_degree, -1, -1, 1.0, starting_order, weight_of_original_value, weight_of_new_value);
+    }
+
+    /*! \brief Evaluates the scalar Taylor polynomial basis for a dimension and degree known at compile time
+     *  delta[j] = weight_of_new_value * (calculation of this function)
+
+        Produces the same basis in the same order as evaluate(...), but with fixed loop bounds so that
+        the monomial loops can be unrolled and powers kept in registers rather than thread scratch.
+        Each (x/h)^k/k! is formed once per direction, so no division is needed per monomial.
+
+        \param delta               [out] - storage for the basis, at least getSize(MaxDegree, Dimension) in length
+        \param h                    [in] - epsilon/window size
+        \param x                    [in] - x coordinate (already shifted by target)
+        \param y                    [in] - y coordinate (already shifted by target)
+        \param z                    [in] - z coordinate (already shifted by target)
+        \param weight_of_new_value  [in] - weighting to assign to each basis value (default=1)
+    */
+    template <int Dimension, int MaxDegree>
+    KOKKOS_INLINE_FUNCTION
+    void evaluateFixedDegree(const member_type& teamMember, double* delta, const double h, const double x, const double y, const double z, const double weight_of_new_value = 1.0) {
         Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                int alphax, alphay, alphaz;
-                double alphaf;
-                int i=0, s=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphaz = 0; alphaz <= n; alphaz++){
-                        s = n - alphaz;
-                        for (alphay = 0; alphay <= s; alphay++){
-                            alphax = s - alphay;
-                            alphaf = factorial[alphax]*factorial[alphay]*factorial[alphaz];
-                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[alphax]*y_over_h_to_i[alphay]*z_over_h_to_i[alphaz]/alphaf;
+            // (x/h)^k/k!, with weight_of_new_value folded into the x direction
+            double x_over_h_to_i[MaxDegree+1];
+            double y_over_h_to_i[MaxDegree+1];
+            double z_over_h_to_i[MaxDegree+1];
+            x_over_h_to_i[0] = weight_of_new_value;
+            y_over_h_to_i[0] = 1;
+            z_over_h_to_i[0] = 1;
+            for (int i=1; i<=MaxDegree; ++i) {
+                x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h)/i;
+                if (Dimension>1) y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h)/i;
+                if (Dimension>2) z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h)/i;
+            }
+            int i = 0;
+            if (Dimension==3) {
+                for (int n = 0; n <= MaxDegree; n++){
+                    for (int alphaz = 0; alphaz <= n; alphaz++){
+                        const int s = n - alphaz;
+                        for (int alphay = 0; alphay <= s; alphay++){
+                            const int alphax = s - alphay;
+                            *(delta+i) = x_over_h_to_i[alphax]*y_over_h_to_i[alphay]*z_over_h_to_i[alphaz];
                             i++;
                         }
                     }
                 }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                // (in 2D) \sum_{n=0}^{n=P} \sum_{k=0}^{k=n} (x/h)^(n-k)*(y/h)^k / ((n-k)!k!)
-                int alphax, alphay;
-                double alphaf;
-                int i = 0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphay = 0; alphay <= n; alphay++){
-                        alphax = n - alphay;
-                        alphaf = factorial[alphax]*factorial[alphay];
-                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[alphax]*y_over_h_to_i[alphay]/alphaf;
+            } else if (Dimension==2) {
+                for (int n = 0; n <= MaxDegree; n++){
+                    for (int alphay = 0; alphay <= n; alphay++){
+                        const int alphax = n - alphay;
+                        *(delta+i) = x_over_h_to_i[alphax]*y_over_h_to_i[alphay];
                         i++;
                     }
                 }
             } else {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                x_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                }
-                // (in 1D) \sum_{n=0}^{n=P} (x/h)^n / n!
-                for (int i=starting_order; i<=max_degree; ++i) {
-                    *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * x_over_h_to_i[i]/factorial[i];
+                for (int n = 0; n <= MaxDegree; n++){
+                    *(delta+n) = x_over_h_to_i[n];
                 }
             }
         });
@@ -121,97 +211,8 @@ namespace ScalarTaylorPolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluatePartialDerivative(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int partial_direction, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
-        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                int alphax, alphay, alphaz;
-                double alphaf;
-                int i=0, s=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphaz = 0; alphaz <= n; alphaz++){
-                        s = n - alphaz;
-                        for (alphay = 0; alphay <= s; alphay++){
-                            alphax = s - alphay;
-
-                            int var_pow[3] = {alphax, alphay, alphaz};
-                            var_pow[partial_direction]--;
-
-                            if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                            } else {
-                                alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                            }
-                            i++;
-                        }
-                    }
-                }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                int alphax, alphay;
-                double alphaf;
-                int i=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphay = 0; alphay <= n; alphay++){
-                        alphax = n - alphay;
-
-                        int var_pow[2] = {alphax, alphay};
-                        var_pow[partial_direction]--;
-
-                        if (var_pow[0]<0 || var_pow[1]<0) {
-                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                        } else {
-                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                        }
-                        i++;
-                    }
-                }
-            } else {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                x_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                }
-                int alphax;
-                double alphaf;
-                int i=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    alphax = n;
-                
-                    int var_pow[1] = {alphax};
-                    var_pow[partial_direction]--;
-
-                    if (var_pow[0]<0) {
-                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                    } else {
-                        alphaf = factorial[var_pow[0]];
-                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]/alphaf;
-                    }
-                    i++;
-                }
-            }
-        });
+        evaluateScaledPowers(teamMember, workspace, dimension, max_degree, h, x, y, z);
+        evaluateFromScaledPowers(teamMember, delta, workspace, dimension, max_degree, partial_direction, -1, 1./h, starting_order, weight_of_original_value, weight_of_new_value);
     }
 
     /*! \brief Evaluates the second partial derivatives of scalar Taylor polynomial basis
@@ -232,97 +233,64 @@ namespace ScalarTaylorPolynomialBasis {
     */
     KOKKOS_INLINE_FUNCTION
     void evaluateSecondPartialDerivative(const member_type& teamMember, double* delta, double* workspace, const int dimension, const int max_degree, const int partial_direction_1, const int partial_direction_2, const double h, const double x, const double y, const double z, const int starting_order = 0, const double weight_of_original_value = 0.0, const double weight_of_new_value = 1.0) {
-        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
-            const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
-            if (dimension==3) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                scratch_vector_type z_over_h_to_i(workspace+2*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                z_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                    z_over_h_to_i[i] = z_over_h_to_i[i-1]*(z/h);
-                }
-                // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                int alphax, alphay, alphaz;
-                double alphaf;
-                int i=0, s=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphaz = 0; alphaz <= n; alphaz++){
-                        s = n - alphaz;
-                        for (alphay = 0; alphay <= s; alphay++){
-                            alphax = s - alphay;
-
-                            int var_pow[3] = {alphax, alphay, alphaz};
-                            var_pow[partial_direction_1]--;
-                            var_pow[partial_direction_2]--;
+        evaluateScaledPowers(teamMember, workspace, dimension, max_degree, h, x, y, z);
+        evaluateFromScaledPowers(teamMember, delta, workspace, dimension, max_degree, partial_direction_1, partial_direction_2, 1./h/h, starting_order, weight_of_original_value, weight_of_new_value);
+    }
 
-                            if (var_pow[0]<0 || var_pow[1]<0 || var_pow[2]<0) {
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                            } else {
-                                alphaf = factorial[var_pow[0]]*factorial[var_pow[1]]*factorial[var_pow[2]];
-                                *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]*z_over_h_to_i[var_pow[2]]/alphaf;
-                            }
-                            i++;
-                        }
-                    }
-                }
-            } else if (dimension==2) {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                scratch_vector_type y_over_h_to_i(workspace+1*(max_degree+1), max_degree+1);
-                x_over_h_to_i[0] = 1;
-                y_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
-                    y_over_h_to_i[i] = y_over_h_to_i[i-1]*(y/h);
-                }
-                // (in 3D) \sum_{p=0}^{p=P} \sum_{k1+k2+k3=n} (x/h)^k1*(y/h)^k2*(z/h)^k3 / (k1!k2!k3!)
-                int alphax, alphay;
-                double alphaf;
-                int i=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    for (alphay = 0; alphay <= n; alphay++){
-                        alphax = n - alphay;
+    /*! \brief Evaluates the scalar Taylor polynomial basis along with its first and second partial derivatives
+     *  (the "jet" of the basis) from a single set of powers
 
-                        int var_pow[2] = {alphax, alphay};
-                        var_pow[partial_direction_1]--;
-                        var_pow[partial_direction_2]--;
+        Each requested output is overwritten with getSize(max_degree, dimension) values. Outputs that are
+        NULL are skipped, so any combination of values and partial derivatives is evaluated in one pass over
+        the basis, with each basis function's exponents decoded once.
 
-                        if (var_pow[0]<0 || var_pow[1]<0) {
-                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                        } else {
-                            alphaf = factorial[var_pow[0]]*factorial[var_pow[1]];
-                            *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]*y_over_h_to_i[var_pow[1]]/alphaf;
-                        }
-                        i++;
-                    }
+        \param value               [out] - basis values, or NULL
+        \param partials            [out] - partials[d] for the first partial derivative in direction d, or NULL
+                                           (either the array or any of its first dimension entries)
+        \param second_partials     [out] - second_partials[d1*3+d2] for the second partial derivative in directions
+                                           d1 and d2, or NULL (either the array or any of its entries)
+        \param workspace       [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large as the _poly_order*the spatial dimension of the polynomial basis.
+        \param dimension            [in] - spatial dimension to evaluate
+        \param max_degree           [in] - highest degree of polynomial
+        \param h                    [in] - epsilon/window size
+        \param x                    [in] - x coordinate (already shifted by target)
+        \param y                    [in] - y coordinate (already shifted by target)
+        \param z                    [in] - z coordinate (already shifted by target)
+    */
+    KOKKOS_INLINE_FUNCTION
+    void evaluateJet(const member_type& teamMember, double* value, double* const* partials, double* const* second_partials, double* workspace, const int dimension, const int max_degree, const double h, const double x, const double y, const double z) {
+        evaluateScaledPowers(teamMember, workspace, dimension, max_degree, h, x, y, z);
+        const int count = getSize(max_degree, dimension);
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, count), [&] (const int i) {
+            int alpha[3];
+            getMultiIndex(dimension, i, alpha[0], alpha[1], alpha[2]);
+            // product of the scaled powers, with the exponent in direction d lowered by lower[d]
+            auto scaled_product = [&] (const int* lower) {
+                double product = 1.0;
+                for (int d=0; d<dimension; ++d) {
+                    const int power = alpha[d] - lower[d];
+                    if (power < 0) return 0.0;
+                    product *= workspace[d*(max_degree+1) + power];
                 }
-            } else {
-                scratch_vector_type x_over_h_to_i(workspace, max_degree+1);
-                x_over_h_to_i[0] = 1;
-                for (int i=1; i<=max_degree; ++i) {
-                    x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
+                return product;
+            };
+            if (value != NULL) {
+                const int lower[3] = {0, 0, 0};
+                value[i] = scaled_product(lower);
+            }
+            for (int d1=0; d1<dimension; ++d1) {
+                if (partials != NULL && partials[d1] != NULL) {
+                    int lower[3] = {0, 0, 0};
+                    lower[d1]++;
+                    partials[d1][i] = 1./h * scaled_product(lower);
                 }
-                int alphax;
-                double alphaf;
-                int i=0;
-                for (int n = starting_order; n <= max_degree; n++){
-                    alphax = n;
-                
-                    int var_pow[1] = {alphax};
-                    var_pow[partial_direction_1]--;
-                    var_pow[partial_direction_2]--;
-
-                    if (var_pow[0]<0) {
-                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 0.0;
-                    } else {
-                        alphaf = factorial[var_pow[0]];
-                        *(delta+i) = weight_of_original_value * *(delta+i) + weight_of_new_value * 1./h * x_over_h_to_i[var_pow[0]]/alphaf;
+                for (int d2=0; d2<dimension; ++d2) {
+                    if (second_partials != NULL && second_partials[d1*3+d2] != NULL) {
+                        int lower[3] = {0, 0, 0};
+                        lower[d1]++;
+                        lower[d2]++;
+                        second_partials[d1*3+d2][i] = 1./h/h * scaled_product(lower);
                     }
-                    i++;
                 }
             }
         });
@@ -0,0 +1,42 @@
+#ifndef __KOKKOSBATCHED_UTV_TEAMVECTOR_BLOCKED_IMPL_COMPADRE_HPP__
+#define __KOKKOSBATCHED_UTV_TEAMVECTOR_BLOCKED_IMPL_COMPADRE_HPP__
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_UTV_Decl.hpp"
+#include "KokkosBatched_UTV_TeamVector_Blocked_Internal_Compadre.hpp"
+
+namespace KokkosBatched {
+
+    ///
+    /// TeamVector Impl
+    /// ===============
+    template<typename MemberType>
+    struct TeamVectorUTV<MemberType,Algo::UTV::Blocked> {
+        template<typename AViewType,
+             typename pViewType,
+             typename UViewType,
+             typename VViewType,
+             typename wViewType>
+        KOKKOS_INLINE_FUNCTION
+        static int
+        invoke(const MemberType &member,
+             const AViewType &A,
+             const pViewType &p,
+             const UViewType &U,
+             const VViewType &V,
+             const wViewType &w,
+             int &matrix_rank) {
+              return TeamVectorUTV_Blocked_Internal_Compadre::
+                invoke(member,
+                   A.extent(0), A.extent(1),
+                   A.data(), A.stride(0), A.stride(1),
+                   p.data(), p.stride(0),
+                   U.data(), U.stride(0), U.stride(1),
+                   V.data(), V.stride(0), V.stride(1),
+                   w.data(),
+                   matrix_rank);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef __KOKKOSBATCHED_UTV_TEAMVECTOR_BLOCKED_INTERNAL_COMPADRE_HPP__
+#define __KOKKOSBATCHED_UTV_TEAMVECTOR_BLOCKED_INTERNAL_COMPADRE_HPP__
+
+
+#include "KokkosBatched_Util.hpp"
+
+#include "KokkosBatched_SetTriangular_Internal.hpp"
+#include "KokkosBatched_Gemm_TeamVector_Internal.hpp"
+#include "KokkosBatched_QR_TeamVector_Internal.hpp"
+#include "KokkosBatched_QR_WithColumnPivoting_TeamVector_Internal.hpp"
+#include "KokkosBatched_QR_FormQ_TeamVector_Internal.hpp"
+
+namespace KokkosBatched {
+
+    /// TeamVector Internal
+    /// ===================
+    //
+    // Blocked variant of TeamVectorQR_WithColumnPivotingInternal from
+    // KokkosKernels. Householder reflectors are generated a panel at a time
+    // (following LAPACK's xLAQPS), with the trailing matrix only updated by
+    // the current row as each reflector is generated. The remaining update
+    // of the trailing matrix is then applied once per panel as
+    //
+    //   A22 := A22 - V F^T
+    //
+    // which is GEMM shaped. Column norms are downdated the same way as in
+    // the unblocked algorithm, so rank detection and pivots are unchanged.
+    //
+    // Householder reflectors follow the flame convention, H = I - u u^T / tau.
+    //
+    struct TeamVectorQR_WithColumnPivotingBlockedInternal_Compadre {
+
+    //! number of reflectors generated before the trailing matrix is updated
+    KOKKOS_INLINE_FUNCTION
+    static constexpr int blockSize() { return 8; }
+
+    //! workspace needed in addition to that of the unblocked algorithm
+    KOKKOS_INLINE_FUNCTION
+    static constexpr int extraWorkspaceSize(const int n) { return n*blockSize() + blockSize(); }
+
+    template<typename MemberType,
+             typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const MemberType &member,
+           const int m, // m = NumRows(A)
+           const int n, // n = NumCols(A)
+           /* */ ValueType * A, const int as0, const int as1,
+           /* */ ValueType * t, const int ts0,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * w, // n + n*blockSize() + blockSize()
+           /* */ int &matrix_rank) {
+
+        typedef ValueType value_type;
+        typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+        const int nb = blockSize();
+        const int min_mn = m < n ? m : n;
+
+        // workspace
+        value_type * norm = w; w += n;
+        // F is (n x nb), with F(j,l) at F[j*nb+l]
+        value_type * F = w; w += n*nb;
+        value_type * aux = w;
+
+        // compute initial column norms (replaced by dot product)
+        TeamVectorDotInternal::invoke(member,
+                                      m, n,
+                                      A, as0, as1,
+                                      A, as0, as1,
+                                      norm, 1);
+        member.team_barrier();
+
+        const bool finish_when_rank_found = (matrix_rank == -1);
+
+        matrix_rank = min_mn;
+        value_type max_diag(0);
+
+        for (int k0=0; k0<min_mn; k0+=nb) {
+            const int kb = (nb < min_mn-k0) ? nb : min_mn-k0;
+
+            for (int k=0; k<kb; ++k) {
+                const int c = k0 + k;
+                const int m_A22 = m - c - 1;
+                const int n_A22 = n - c - 1;
+
+                // find max location
+                TeamVectorFindAmaxInternal::invoke(member,
+                                                   n - c,
+                                                   norm + c, 1,
+                                                   p + c*ps0);
+                member.team_barrier();
+                const int piv = p[c*ps0];
+
+                // apply pivot to norms, A, and the rows of F computed so far
+                TeamVectorApplyPivotVectorForwardInternal::invoke(member,
+                                                                  piv,
+                                                                  norm + c, 1);
+                TeamVectorApplyPivotMatrixForwardInternal::invoke(member,
+                                                                  m,
+                                                                  piv,
+                                                                  A + c*as1, as1, as0);
+                TeamVectorApplyPivotMatrixForwardInternal::invoke(member,
+                                                                  k,
+                                                                  piv,
+                                                                  F + (c-k0)*nb, nb, 1);
+                member.team_barrier();
+
+                // apply previous reflectors of this panel to column c
+                // A(c:m,c) -= A(c:m,k0:c) F(c-k0,0:k)^T
+                if (k > 0) {
+                    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m-c), [&](const int &ii) {
+                        const int i = c + ii;
+                        value_type tmp(0);
+                        for (int l=0; l<k; ++l)
+                            tmp += A[i*as0+(k0+l)*as1]*F[(c-k0)*nb+l];
+                        A[i*as0+c*as1] -= tmp;
+                    });
+                    member.team_barrier();
+                }
+
+                // perform householder transformation
+                value_type * a11 = A + c*as0 + c*as1;
+                value_type * a21 = a11 + as0;
+                value_type * tau = t + c*ts0;
+                TeamVectorLeftHouseholderInternal::invoke(member,
+                                                          m_A22,
+                                                          a11,
+                                                          a21, as0,
+                                                          tau);
+                member.team_barrier();
+
+                // break condition
+                if (matrix_rank == min_mn) {
+                    if (c == 0) max_diag = ats::abs(A[0]);
+                    const value_type
+                      val_diag = ats::abs(*a11),
+                      threshold(10*max_diag*ats::epsilon());
+                    if (val_diag < threshold) {
+                        matrix_rank = c;
+                        // rows above c are complete, which is all that is needed
+                        if (finish_when_rank_found)
+                            return 0;
+                    }
+                }
+
+                const value_type inv_tau = value_type(1)/(*tau);
+
+                // F(j-k0,k) = A(c:m,j)^T u / tau, for trailing columns j
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(member, n_A22), [&](const int &jj) {
+                    const int j = c + 1 + jj;
+                    value_type tmp(0);
+                    Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member, m_A22), [&](const int &ii, value_type &val) {
+                        val += a21[ii*as0]*A[(c+1+ii)*as0+j*as1];
+                    }, tmp);
+                    Kokkos::single(Kokkos::PerThread(member), [&]() {
+                        F[(j-k0)*nb+k] = (tmp + A[c*as0+j*as1])*inv_tau;
+                    });
+                });
+
+                if (k > 0) {
+                    // aux(l) = -A(c:m,k0+l)^T u / tau
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, k), [&](const int &l) {
+                        value_type tmp(0);
+                        Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(member, m_A22), [&](const int &ii, value_type &val) {
+                            val += a21[ii*as0]*A[(c+1+ii)*as0+(k0+l)*as1];
+                        }, tmp);
+                        Kokkos::single(Kokkos::PerThread(member), [&]() {
+                            aux[l] = -(tmp + A[c*as0+(k0+l)*as1])*inv_tau;
+                        });
+                    });
+                    member.team_barrier();
+
+                    // F(:,k) += F(:,0:k) aux
+                    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n_A22), [&](const int &jj) {
+                        const int j = c + 1 + jj - k0;
+                        value_type tmp(0);
+                        for (int l=0; l<k; ++l)
+                            tmp += F[j*nb+l]*aux[l];
+                        F[j*nb+k] += tmp;
+                    });
+                }
+                member.team_barrier();
+
+                // update row c of the trailing matrix
+                // A(c,c+1:n) -= A(c,k0:c+1) F(c+1-k0:n-k0,0:k+1)^T, with unit diagonal in A(c,c)
+                Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n_A22), [&](const int &jj) {
+                    const int j = c + 1 + jj;
+                    value_type tmp = F[(j-k0)*nb+k];
+                    for (int l=0; l<k; ++l)
+                        tmp += A[c*as0+(k0+l)*as1]*F[(j-k0)*nb+l];
+                    A[c*as0+j*as1] -= tmp;
+                });
+                member.team_barrier();
+
+                // norm update
+                TeamVectorUpdateColumnNormsInternal::invoke(member,
+                                                            n_A22,
+                                                            A + c*as0 + (c+1)*as1, as1,
+                                                            norm + c + 1, 1);
+                member.team_barrier();
+            }
+
+            // update trailing matrix with the panel
+            // A(k0+kb:m,k0+kb:n) -= A(k0+kb:m,k0:k0+kb) F(kb:n-k0,0:kb)^T
+            TeamVectorGemmInternal<Algo::Gemm::Unblocked>::invoke(member,
+                                                                  m - k0 - kb, n - k0 - kb, kb,
+                                                                  value_type(-1),
+                                                                  A + (k0+kb)*as0 + k0*as1, as0, as1,
+                                                                  F + kb*nb, 1, nb,
+                                                                  value_type(1),
+                                                                  A + (k0+kb)*as0 + (k0+kb)*as1, as0, as1);
+            member.team_barrier();
+        }
+        return 0;
+    }
+    };
+
+    //
+    // Attention!: This is a fork of TeamVectorUTV_Internal from
+    // KokkosKernels that uses the blocked QR with column pivoting above.
+    //
+    struct TeamVectorUTV_Blocked_Internal_Compadre {
+    template<typename MemberType,
+             typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const MemberType &member,
+           const int m, const int n, // m = NumRows(A)
+           /* */ ValueType * A, const int as0, const int as1,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * U, const int us0, const int us1,
+           /* */ ValueType * V, const int vs0, const int vs1,
+           /* */ ValueType * w, // 3*m + n*blockSize() + blockSize(), tau, norm, householder workspace
+           /* */ int &matrix_rank) {
+
+        typedef ValueType value_type;
+
+        value_type *t = w; w+= m;
+        const int ts0(1);
+
+        value_type *work = w;
+
+        matrix_rank = -1;
+        TeamVectorQR_WithColumnPivotingBlockedInternal_Compadre
+          ::invoke(member,
+                   m, n,
+                   A, as0, as1,
+                   t, ts0,
+                   p, ps0,
+                   work,
+                   matrix_rank);
+
+        TeamVectorQR_FormQ_Internal
+          ::invoke(member,
+                   m, matrix_rank, matrix_rank,
+                   A, as0, as1,
+                   t, ts0,
+                   U, us0, us1,
+                   work);
+        member.team_barrier();
+
+        /// for rank deficient matrix
+        if (matrix_rank < n) {
+            const value_type zero(0);
+            TeamVectorSetLowerTriangularInternal
+              ::invoke(member,
+                       matrix_rank, matrix_rank,
+                       1, zero,
+                       A, as0, as1);
+
+            TeamVectorQR_Internal
+              ::invoke(member,
+                       n, matrix_rank,
+                       A, as1, as0,
+                       t, ts0,
+                       work);
+
+            TeamVectorQR_FormQ_Internal
+              ::invoke(member,
+                       n, matrix_rank, matrix_rank,
+                       A, as1, as0,
+                       t, ts0,
+                       V, vs1, vs0,
+                       work);
+        }
+
+        return 0;
+    }
+    };
+
+} // end namespace KokkosBatched
+
+#endif